@@ -0,0 +1,129 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <chrono>
+#include <ctime>
+#include <thread>
+#include <iostream>
+#include <algorithm>
+#include "BenchmarkRunner.h"
+
+/**
+ * Returns the specified text as quoted JSON string.
+ */
+static std::string Quote(const std::string & text)
+{
+    std::string result = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result + "\"";
+}
+
+BenchmarkRunner::BenchmarkRunner(double _minTime, size_t _maxIterations)
+    : minTime(_minTime)
+    , maxIterations(_maxIterations)
+{
+    // Intentionally left empty.
+}
+
+void BenchmarkRunner::SetFilter(const std::string & _filter)
+{
+    filter = _filter;
+}
+
+bool BenchmarkRunner::IsEnabled(const std::string & name) const
+{
+    return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+const BenchmarkResult & BenchmarkRunner::Run(const std::string & name, size_t numItems, const Body & body)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Warm-up, e.g., to grow buffers to their final size.
+    body();
+
+    BenchmarkResult result;
+    result.name = name;
+    result.numItems = numItems;
+    result.iterations = 0;
+    result.realTime = 0;
+    result.minTime = 0;
+    result.maxTime = 0;
+
+    std::clock_t cpuStart = std::clock();
+    while (result.iterations < maxIterations && (result.iterations == 0 || result.realTime < minTime)) {
+        auto start = Clock::now();
+        body();
+        double t = std::chrono::duration<double>(Clock::now() - start).count();
+
+        result.minTime = result.iterations == 0 ? t : std::min(result.minTime, t);
+        result.maxTime = std::max(result.maxTime, t);
+        result.realTime += t;
+        ++result.iterations;
+    }
+    result.cpuTime = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+    std::cout << name << ": " << result.iterations << " iterations, "
+        << 1000.0 * result.realTime / result.iterations << " ms/iteration (min "
+        << 1000.0 * result.minTime << " ms, max "
+        << 1000.0 * result.maxTime << " ms)" << std::endl;
+
+    results.push_back(result);
+    return results.back();
+}
+
+void BenchmarkRunner::WriteJson(std::ostream & os, const std::string & executable) const
+{
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    os << "{\n";
+    os << "  \"context\": {\n";
+    os << "    \"date\": \"" << date << "\",\n";
+    os << "    \"executable\": " << Quote(executable) << ",\n";
+    os << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+    os << "    \"library_build_type\": \"release\"\n";
+#else
+    os << "    \"library_build_type\": \"debug\"\n";
+#endif
+    os << "  },\n";
+    os << "  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto & r = results[i];
+        double perIteration = 1e9 / r.iterations;
+        os << (i == 0 ? "\n" : ",\n");
+        os << "    {\n";
+        os << "      \"name\": " << Quote(r.name) << ",\n";
+        os << "      \"run_name\": " << Quote(r.name) << ",\n";
+        os << "      \"run_type\": \"iteration\",\n";
+        os << "      \"iterations\": " << r.iterations << ",\n";
+        os << "      \"real_time\": " << r.realTime * perIteration << ",\n";
+        os << "      \"cpu_time\": " << r.cpuTime * perIteration << ",\n";
+        os << "      \"min_time\": " << r.minTime * 1e9 << ",\n";
+        os << "      \"max_time\": " << r.maxTime * 1e9 << ",\n";
+        os << "      \"time_unit\": \"ns\",\n";
+        os << "      \"entities\": " << r.numItems << ",\n";
+        os << "      \"items_per_second\": " 
+            << (r.realTime > 0 ? r.numItems * r.iterations / r.realTime : 0) << "\n";
+        os << "    }";
+    }
+
+    os << "\n  ]\n";
+    os << "}\n";
+}
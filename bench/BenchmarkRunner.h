@@ -0,0 +1,123 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <ostream>
+#include <cstddef>
+
+/**
+ * The measured result of a single benchmark.
+ */
+struct BenchmarkResult {
+    /** The name of the benchmark, including the number of items. */
+    std::string name;
+
+    /** The number of items processed by each iteration, e.g., entities. */
+    size_t numItems;
+
+    /** The number of measured iterations. */
+    size_t iterations;
+
+    /** The total wall time of all iterations in seconds. */
+    double realTime;
+
+    /** The total processor time of all iterations in seconds. */
+    double cpuTime;
+
+    /** The wall time of the fastest iteration in seconds. */
+    double minTime;
+
+    /** The wall time of the slowest iteration in seconds. */
+    double maxTime;
+};
+
+/**
+ * A minimal benchmark harness.
+ * 
+ * Each benchmark is a function which is called repeatedly until a minimum
+ * amount of time has passed. The results can be written as JSON, using
+ * the same layout as Google Benchmark, so existing tools can compare runs
+ * of different commits.
+ */
+class BenchmarkRunner {
+public:
+
+    /** The function measured by a benchmark, one call per iteration. */
+    using Body = std::function<void()>;
+
+    /**
+     * Constructor.
+     * 
+     * @param minTime       the minimum time to run each benchmark in seconds
+     * @param maxIterations the maximum number of iterations of each benchmark
+     */
+    BenchmarkRunner(double minTime = 0.5, size_t maxIterations = 10000);
+
+    /**
+     * Only benchmarks containing the specified text will be run.
+     * 
+     * @param filter    the filter text, empty to run all benchmarks
+     */
+    void SetFilter(const std::string & filter);
+
+    /**
+     * Tests whether a benchmark passes the filter.
+     * 
+     * @param name  the name of the benchmark
+     * @return `true` if the benchmark should be run
+     */
+    bool IsEnabled(const std::string & name) const;
+
+    /**
+     * Runs a benchmark and records its result.
+     * 
+     * The body is called once for warm-up before the measurement starts.
+     * 
+     * @param name      the name of the benchmark
+     * @param numItems  the number of items processed by each iteration
+     * @param body      the function to measure
+     */
+    const BenchmarkResult & Run(const std::string & name, size_t numItems, const Body & body);
+
+    /**
+     * Returns the results of all benchmarks run so far.
+     * 
+     * @return the benchmark results
+     */
+    const std::vector<BenchmarkResult> & GetResults() const {
+        return results;
+    }
+
+    /**
+     * Writes the results as JSON.
+     * 
+     * @param os            the output stream
+     * @param executable    the name of the benchmark executable
+     */
+    void WriteJson(std::ostream & os, const std::string & executable) const;
+
+private:
+    /** The minimum time to run each benchmark in seconds. */
+    double minTime;
+
+    /** The maximum number of iterations of each benchmark. */
+    size_t maxIterations;
+
+    /** Only benchmarks containing this text are run. */
+    std::string filter;
+
+    /** The results of all benchmarks run so far. */
+    std::vector<BenchmarkResult> results;
+};
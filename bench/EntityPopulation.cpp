@@ -0,0 +1,38 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include "EntityPopulation.h"
+
+using namespace astu;
+
+EntityPopulation::EntityPopulation(size_t n, Factory f)
+    : BaseService("Entity Population")
+    , numEntities(n)
+    , factory(f)
+{
+    // Intentionally left empty.
+}
+
+void EntityPopulation::OnStartup()
+{
+    auto & es = GetSM().GetService<EntityService>();
+    entities.reserve(numEntities);
+    for (size_t i = 0; i < numEntities; ++i) {
+        entities.push_back(factory(i));
+        es.AddEntity(entities.back());
+    }
+}
+
+void EntityPopulation::OnShutdown()
+{
+    entities.clear();
+    entities.shrink_to_fit();
+}
@@ -0,0 +1,70 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <functional>
+#include <Service.h>
+#include <EntityService.h>
+
+/**
+ * Populates the entity service with a number of entities on startup.
+ */
+class EntityPopulation : public astu::BaseService {
+public:
+
+    /** Creates the entity with the specified index. */
+    using Factory = std::function<std::shared_ptr<astu::Entity>(size_t)>;
+
+    /**
+     * Constructor.
+     * 
+     * @param numEntities   the number of entities to create
+     * @param factory       creates the entities
+     */
+    EntityPopulation(size_t numEntities, Factory factory);
+
+    /**
+     * Returns the created entities.
+     * 
+     * @return the entities
+     */
+    std::vector<std::shared_ptr<astu::Entity>> & GetEntities() {
+        return entities;
+    }
+
+    /**
+     * Returns the factory used to create the entities.
+     * 
+     * @return the factory
+     */
+    const Factory & GetFactory() const {
+        return factory;
+    }
+
+protected:
+
+    // Inherited via BaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+
+private:
+    /** The number of entities to create. */
+    size_t numEntities;
+
+    /** Creates the entities. */
+    Factory factory;
+
+    /** The created entities. */
+    std::vector<std::shared_ptr<astu::Entity>> entities;
+};
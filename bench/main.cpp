@@ -0,0 +1,334 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+// Standard C++ Libryry
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+// AST Utilities
+#include <AstUtils.h>
+#include <ServiceManager.h>
+#include <UpdateService.h>
+#include <StateService.h>
+#include <EntityService.h>
+
+// Bagaga Commons
+#include "NullLineRenderer.h"
+#include "SdlLineRenderer.h"
+#include "FixedTimeService.h"
+#include "HeadlessWindowManager.h"
+#include "PolylineVisualSystem.h"
+#include "AutoRotateSystem.h"
+#include "LinearMovementSystem.h"
+#include "CollisionDetectionSystem.h"
+#include "SoaComponentStore.h"
+#include "JobSystem.h"
+#include "Pose2D.h"
+#include "AutoRotate.h"
+#include "LinearMovement.h"
+#include "CircleCollider.h"
+#include "Polyline.h"
+
+// Benchmark harness
+#include "BenchmarkRunner.h"
+#include "EntityPopulation.h"
+
+using namespace std;
+using namespace astu;
+
+/** The entity counts each benchmark is run with. */
+const size_t kEntityCounts[] = {1000, 10000, 100000, 1000000};
+
+/** The area of the world per entity in pixels, keeps the density constant. */
+const double kAreaPerEntity = 40.0 * 40.0;
+
+/** The radius of the entities. */
+const double kEntityRadius = 10.0;
+
+/** The name of the state without services, used between benchmarks. */
+const std::string kIdleState = "Idle";
+
+/** Adds the services of a benchmark to the state with the specified name. */
+using StateBuilder = std::function<void(StateService &, const std::string &)>;
+
+/** The shape of all entities. */
+std::shared_ptr<Polyline::Polygon> shape;
+
+/**
+ * Adds services required for all benchmarks.
+ */
+void AddCoreServices()
+{
+	// Fetch service manager (realized as a singleton)
+	auto &sm = ServiceManager::GetInstance();
+
+	sm.AddService(std::make_shared<UpdateService>());
+	sm.AddService(std::make_shared<StateService>());
+	sm.AddService(std::make_shared<JobSystem>());
+	sm.AddService(std::make_shared<HeadlessWindowManager>());
+	sm.AddService(std::make_shared<FixedTimeService>());
+}
+
+/**
+ * Returns a random position within the world.
+ */
+Vector2<double> RandomPosition()
+{
+	auto & wm = ServiceManager::GetInstance().GetService<IWindowManager>();
+	return Vector2<double>(
+		GetRandomDouble(kEntityRadius, wm.GetWidth() - kEntityRadius),
+		GetRandomDouble(kEntityRadius, wm.GetHeight() - kEntityRadius));
+}
+
+/**
+ * Returns a random velocity.
+ */
+Vector2<double> RandomVelocity()
+{
+	double a = GetRandomDouble(0, 2 * 3.14159265358979);
+	double v = GetRandomDouble(50, 150);
+	return Vector2<double>(std::cos(a) * v, std::sin(a) * v);
+}
+
+std::shared_ptr<Entity> CreateRotatingEntity(size_t)
+{
+	auto entity = std::make_shared<Entity>();
+	entity->AddComponent(std::make_shared<Pose2D>(RandomPosition()));
+	entity->AddComponent(std::make_shared<AutoRotate>(ToRadians(GetRandomDouble(-180, 180))));
+	return entity;
+}
+
+std::shared_ptr<Entity> CreateMovingEntity(size_t)
+{
+	auto entity = std::make_shared<Entity>();
+	entity->AddComponent(std::make_shared<Pose2D>(RandomPosition()));
+	entity->AddComponent(std::make_shared<LinearMovement>(RandomVelocity()));
+	return entity;
+}
+
+std::shared_ptr<Entity> CreateDenseMovingEntity(size_t)
+{
+	auto & store = ServiceManager::GetInstance().GetService<SoaComponentStore>();
+	LinearMovement movement(RandomVelocity());
+
+	auto entity = std::make_shared<Entity>();
+	entity->AddComponent(store.CreateSlot(Pose2D(RandomPosition()), &movement));
+	return entity;
+}
+
+std::shared_ptr<Entity> CreateVisualEntity(size_t)
+{
+	auto entity = std::make_shared<Entity>();
+	entity->AddComponent(std::make_shared<Pose2D>(RandomPosition(), GetRandomDouble(0, 6)));
+	entity->AddComponent(std::make_shared<Polyline>(shape));
+	return entity;
+}
+
+std::shared_ptr<Entity> CreateColliderEntity(size_t)
+{
+	auto entity = std::make_shared<Entity>();
+	entity->AddComponent(std::make_shared<Pose2D>(RandomPosition()));
+	entity->AddComponent(std::make_shared<CircleCollider>(kEntityRadius));
+	return entity;
+}
+
+/**
+ * Resizes the world so that the entity density is the same for all entity counts.
+ */
+void ResizeWorld(size_t numEntities)
+{
+	int size = static_cast<int>(std::sqrt(kAreaPerEntity * numEntities));
+	ServiceManager::GetInstance().GetService<IWindowManager>().SetSize(size, size);
+}
+
+/**
+ * Runs a benchmark which updates all services of a dedicated state per iteration.
+ * 
+ * @param runner		the benchmark runner
+ * @param name			the name of the benchmark
+ * @param numEntities	the number of entities
+ * @param builder		adds the services to the benchmark state
+ * @param body			the function to measure, updates all services if empty
+ */
+void RunStateBenchmark(BenchmarkRunner & runner, const std::string & name, size_t numEntities, 
+	const StateBuilder & builder, BenchmarkRunner::Body body = nullptr)
+{
+	if (!runner.IsEnabled(name)) {
+		return;
+	}
+
+	auto & sm = ServiceManager::GetInstance();
+	auto & ss = sm.GetService<StateService>();
+	ResizeWorld(numEntities);
+	ss.CreateState(name);
+	builder(ss, name);
+	ss.SwitchState(name);
+
+	if (!body) {
+		auto & updater = sm.GetService<UpdateService>();
+		body = [&updater]() { updater.UpdateAll(); };
+	}
+	runner.Run(name, numEntities, body);
+
+	// Release the entities of this benchmark.
+	ss.SwitchState(kIdleState);
+}
+
+void RunSystemBenchmarks(BenchmarkRunner & runner, size_t n)
+{
+	auto suffix = "/" + std::to_string(n);
+
+	RunStateBenchmark(runner, "AutoRotateSystem" + suffix, n, [n](StateService & ss, const std::string & state) {
+		ss.AddService(state, std::make_shared<EntityService>());
+		ss.AddService(state, std::make_shared<AutoRotateSystem>());
+		ss.AddService(state, std::make_shared<EntityPopulation>(n, CreateRotatingEntity));
+	});
+
+	RunStateBenchmark(runner, "LinearMovementSystem" + suffix, n, [n](StateService & ss, const std::string & state) {
+		ss.AddService(state, std::make_shared<EntityService>());
+		ss.AddService(state, std::make_shared<LinearMovementSystem>());
+		ss.AddService(state, std::make_shared<EntityPopulation>(n, CreateMovingEntity));
+	});
+
+	RunStateBenchmark(runner, "LinearMovementSystemDense" + suffix, n, [n](StateService & ss, const std::string & state) {
+		ss.AddService(state, std::make_shared<EntityService>());
+		ss.AddService(state, std::make_shared<SoaComponentStore>(n));
+		ss.AddService(state, std::make_shared<LinearMovementSystem>());
+		ss.AddService(state, std::make_shared<EntityPopulation>(n, CreateDenseMovingEntity));
+	});
+
+	RunStateBenchmark(runner, "PolylineVisualSystem" + suffix, n, [n](StateService & ss, const std::string & state) {
+		ss.AddService(state, std::make_shared<EntityService>());
+		ss.AddService(state, std::make_shared<NullLineRenderer>());
+		ss.AddService(state, std::make_shared<PolylineVisualSystem>());
+		ss.AddService(state, std::make_shared<EntityPopulation>(n, CreateVisualEntity));
+	});
+
+	RunStateBenchmark(runner, "CollisionDetectionSystem" + suffix, n, [n](StateService & ss, const std::string & state) {
+		ss.AddService(state, std::make_shared<EntityService>());
+		ss.AddService(state, std::make_shared<CollisionDetectionSystem>());
+		ss.AddService(state, std::make_shared<EntityPopulation>(n, CreateColliderEntity));
+	});
+}
+
+void RunChurnBenchmark(BenchmarkRunner & runner, size_t n)
+{
+	// Each iteration replaces one percent of the entities, no system runs
+	// in between so only adding and removing entities is measured.
+	auto population = std::make_shared<EntityPopulation>(n, CreateRotatingEntity);
+	size_t next = 0;
+	auto churn = [population, n, &next]() {
+		auto & es = ServiceManager::GetInstance().GetService<EntityService>();
+		auto & entities = population->GetEntities();
+		size_t numReplaced = std::max<size_t>(1, n / 100);
+		for (size_t i = 0; i < numReplaced; ++i) {
+			es.RemoveEntity(entities[next]);
+			entities[next] = population->GetFactory()(next);
+			es.AddEntity(entities[next]);
+			next = (next + 1) % n;
+		}
+	};
+
+	RunStateBenchmark(runner, "EntityServiceChurn/" + std::to_string(n), n, 
+		[population](StateService & ss, const std::string & state) {
+			ss.AddService(state, std::make_shared<EntityService>());
+			ss.AddService(state, population);
+		}, churn);
+}
+
+void RunLineRecordingBenchmark(BenchmarkRunner & runner, size_t n)
+{
+	auto name = "SdlLineRendererRecording/" + std::to_string(n);
+	if (!runner.IsEnabled(name)) {
+		return;
+	}
+
+	// Only records and submits frames, replay requires a SDL renderer.
+	const Color colors[] = {WebColors::Red, WebColors::Green, WebColors::Blue, WebColors::Yellow};
+	SdlLineRenderer renderer;
+	runner.Run(name, n, [&renderer, &colors, n]() {
+		for (size_t i = 0; i < n; ++i) {
+			renderer.SetDrawColor(colors[i % 4]);
+			renderer.DrawLineStrip(shape->data(), shape->size(), true);
+		}
+		renderer.SubmitFrame();
+	});
+}
+
+void PrintUsage(const char* executable)
+{
+	std::cerr << "usage: " << executable 
+		<< " [--filter <text>] [--max-entities <n>] [--min-time <seconds>] [--out <file>]" 
+		<< std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	SayVersion();
+
+	std::string filter;
+	std::string outFile = "benchmarks.json";
+	size_t maxEntities = 1000000;
+	double minTime = 0.5;
+	for (int i = 1; i < argc; ++i) {
+		if (i + 1 < argc && std::strcmp(argv[i], "--filter") == 0) {
+			filter = argv[++i];
+		} else if (i + 1 < argc && std::strcmp(argv[i], "--max-entities") == 0) {
+			maxEntities = std::strtoul(argv[++i], nullptr, 10);
+		} else if (i + 1 < argc && std::strcmp(argv[i], "--min-time") == 0) {
+			minTime = std::atof(argv[++i]);
+		} else if (i + 1 < argc && std::strcmp(argv[i], "--out") == 0) {
+			outFile = argv[++i];
+		} else {
+			PrintUsage(argv[0]);
+			return -1;
+		}
+	}
+
+	shape = std::make_shared<Polyline::Polygon>();
+	shape->push_back(Vector2<double>(-kEntityRadius, -kEntityRadius));
+	shape->push_back(Vector2<double>(kEntityRadius, -kEntityRadius));
+	shape->push_back(Vector2<double>(0, kEntityRadius));
+
+	AddCoreServices();
+	auto & sm = ServiceManager::GetInstance();
+	sm.GetService<StateService>().CreateState(kIdleState);
+	sm.StartupAll();
+	sm.GetService<StateService>().SwitchState(kIdleState);
+
+	BenchmarkRunner runner(minTime);
+	runner.SetFilter(filter);
+	for (size_t n : kEntityCounts) {
+		if (n > maxEntities) {
+			break;
+		}
+		RunSystemBenchmarks(runner, n);
+		RunLineRecordingBenchmark(runner, n);
+		RunChurnBenchmark(runner, n);
+	}
+
+	sm.ShutdownAll();
+
+	std::ofstream out(outFile);
+	if (!out) {
+		std::cerr << "unable to write benchmark results to " << outFile << std::endl;
+		return -1;
+	}
+	runner.WriteJson(out, argv[0]);
+	std::cout << "benchmark results written to " << outFile << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,173 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <ITimeService.h>
+#include "Pose2D.h"
+#include "Polyline.h"
+#include "InterpolationService.h"
+
+#define MAX_BUFFERED_SNAPSHOTS 32
+#define MAX_DRIFT 0.25
+#define DRIFT_CORRECTION 0.05
+
+using namespace astu;
+
+InterpolationService::InterpolationService(double delay, int priority)
+    : UpdatableBaseService("Interpolation", priority)
+    , delay(delay)
+    , renderTick(0)
+    , latest(SnapshotCodec::NO_BASELINE)
+    , sinceLatest(0)
+{
+    // Intentionally left empty.
+}
+
+void InterpolationService::OnStartup()
+{
+    client = GetSM().FindService<ReplicationClient>();
+    if (!client) {
+        throw std::logic_error("Interpolation requires a replication client");
+    }
+    latest = SnapshotCodec::NO_BASELINE;
+}
+
+void InterpolationService::OnShutdown()
+{
+    auto & es = GetSM().GetService<EntityService>();
+    for (const auto & it : mirrors) {
+        es.RemoveEntity(it.second.entity);
+    }
+    mirrors.clear();
+    client = nullptr;
+}
+
+std::shared_ptr<Entity> InterpolationService::FindEntity(uint32_t id) const
+{
+    auto it = mirrors.find(id);
+    return it != mirrors.end() ? it->second.entity : nullptr;
+}
+
+void InterpolationService::OnUpdate()
+{
+    if (!client->IsConnected()) {
+        return;
+    }
+
+    AdvanceRenderTick(GetSM().GetService<ITimeService>().GetElapsedTime());
+
+    // Search the buffered snapshots enclosing the render time.
+    const Snapshot* from = nullptr;
+    const Snapshot* to = nullptr;
+    for (uint32_t i = 0; i < MAX_BUFFERED_SNAPSHOTS && i < latest; ++i) {
+        const Snapshot* snapshot = client->GetSnapshot(latest - i);
+        if (!snapshot) {
+            continue;
+        }
+        if (snapshot->tick <= renderTick) {
+            from = snapshot;
+            break;
+        }
+        to = snapshot;
+    }
+
+    // Hold the oldest or the latest snapshot outside the buffered range.
+    if (!from) {
+        from = to;
+    } else if (!to) {
+        to = from;
+    }
+    ApplySnapshots(*from, *to);
+}
+
+void InterpolationService::AdvanceRenderTick(double dt)
+{
+    const int tickRate = client->GetClientInfo().tickRate;
+    const uint32_t sequence = client->GetLatestSequence();
+    if (sequence != latest) {
+        latest = sequence;
+        sinceLatest = 0;
+    } else {
+        sinceLatest += dt;
+    }
+
+    // The server tick is estimated from the latest snapshot and the time 
+    // since its arrival. Small deviations caused by jitter are corrected 
+    // gradually, large ones, e.g., after a stall, immediately.
+    const double serverTick = client->GetSnapshot(latest)->tick + sinceLatest * tickRate;
+    const double target = serverTick - delay * tickRate;
+    renderTick += dt * tickRate;
+    if (std::abs(target - renderTick) > MAX_DRIFT * tickRate) {
+        renderTick = target;
+    } else {
+        renderTick += (target - renderTick) * DRIFT_CORRECTION;
+    }
+}
+
+void InterpolationService::ApplySnapshots(const Snapshot & from, const Snapshot & to)
+{
+    double t = 0;
+    if (to.tick > from.tick) {
+        t = std::max(0.0, std::min((renderTick - from.tick) / (to.tick - from.tick), 1.0));
+    }
+
+    auto & es = GetSM().GetService<EntityService>();
+    const uint32_t playerId = client->GetClientInfo().playerId;
+
+    for (const auto & a : from.entities) {
+        auto & mirror = mirrors[a.id];
+
+        // Polylines can not change their shape, replace the entity instead.
+        if (mirror.entity && (mirror.shape != a.shape || mirror.color != a.color)) {
+            es.RemoveEntity(mirror.entity);
+            mirror.entity = nullptr;
+        }
+
+        if (!mirror.entity) {
+            mirror.entity = std::make_shared<Entity>();
+            mirror.entity->AddComponent(std::make_shared<Pose2D>());
+            mirror.entity->AddComponent(std::make_shared<Polyline>(
+                shapes.GetShape(a.shape), SnapshotCodec::DequantizeColor(a.color)));
+            mirror.shape = a.shape;
+            mirror.color = a.color;
+            es.AddEntity(mirror.entity);
+        }
+        mirror.seen = from.sequence;
+
+        if (a.id == playerId) {
+            continue;
+        }
+
+        // Entities removed later on are held at their last known state.
+        const EntityState* b = to.Find(a.id);
+        if (!b) {
+            b = &a;
+        }
+
+        Pose2D poseA(SnapshotCodec::DequantizePosition(a.x), 
+            SnapshotCodec::DequantizePosition(a.y), SnapshotCodec::DequantizeAngle(a.angle));
+        Pose2D poseB(SnapshotCodec::DequantizePosition(b->x), 
+            SnapshotCodec::DequantizePosition(b->y), SnapshotCodec::DequantizeAngle(b->angle));
+        mirror.entity->GetComponent<Pose2D>().SetInterpolated(poseA, poseB, t);
+    }
+
+    // Entities missing in the snapshot have been removed on the server.
+    for (auto it = mirrors.begin(); it != mirrors.end(); ) {
+        if (it->second.seen != from.sequence) {
+            es.RemoveEntity(it->second.entity);
+            it = mirrors.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <UpdateService.h>
+#include <EntityService.h>
+
+#include "ReplicationClient.h"
+#include "ShapeCatalog.h"
+
+/**
+ * Mirrors the replicated entities and renders them in between snapshots.
+ * 
+ * Each replicated entity is represented by a local entity with Pose2D
+ * and Polyline components. The entities are shown slightly
+ * in the past, interpolating between the two buffered snapshots enclosing
+ * the render time, hence entities move smoothly even if snapshots arrive
+ * far less frequently than frames are rendered. The pose of the player
+ * entity is left to the prediction.
+ */
+class InterpolationService : public astu::UpdatableBaseService {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param delay     the time entities are shown in the past in seconds,
+     *                  should span at least two snapshots
+     * @param priority  the update priority of this service
+     */
+    InterpolationService(double delay = 0.1, int priority = 0);
+
+    /**
+     * Returns the local entity mirroring a replicated entity.
+     * 
+     * @param id    the network id of the replicated entity
+     * @return the local entity or null if not known
+     */
+    std::shared_ptr<astu::Entity> FindEntity(uint32_t id) const;
+
+protected:
+
+    // Inherited via UpdatableBaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+    virtual void OnUpdate() override;
+
+private:
+
+    /** A local entity mirroring a replicated entity. */
+    struct Mirror {
+        /** The local entity. */
+        std::shared_ptr<astu::Entity> entity;
+
+        /** The shape of the entity. */
+        uint16_t shape;
+
+        /** The quantized color of the entity. */
+        uint32_t color;
+
+        /** The sequence number of the snapshot the entity has been seen in. */
+        uint32_t seen;
+    };
+
+    /** The time entities are shown in the past in seconds. */
+    double delay;
+
+    /** The server tick currently rendered. */
+    double renderTick;
+
+    /** The sequence number of the latest snapshot known. */
+    uint32_t latest;
+
+    /** The time since the latest snapshot has been received. */
+    double sinceLatest;
+
+    /** The replication client providing the snapshots. */
+    std::shared_ptr<ReplicationClient> client;
+
+    /** The shapes of the replicated entities. */
+    ShapeCatalog shapes;
+
+    /** Maps network ids to local entities. */
+    std::unordered_map<uint32_t, Mirror> mirrors;
+
+    /**
+     * Advances the render time, keeping it behind the server by the delay.
+     * 
+     * @param dt    the elapsed time since the last frame
+     */
+    void AdvanceRenderTick(double dt);
+
+    /**
+     * Updates the local entities to the render time.
+     * 
+     * @param from  the latest snapshot taken before the render time
+     * @param to    the earliest snapshot taken after the render time
+     */
+    void ApplySnapshots(const Snapshot & from, const Snapshot & to);
+};
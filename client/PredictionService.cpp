@@ -0,0 +1,153 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <Mouse.h>
+#include <ITimeService.h>
+#include "PredictionService.h"
+
+#define INPUT_BUFFER_SIZE 64
+#define CORRECTION_RATE 10.0
+#define MAX_CORRECTION 50.0
+
+using namespace astu;
+
+PredictionService::PredictionService(int priority)
+    : UpdatableBaseService("Prediction", priority)
+    , inputs(INPUT_BUFFER_SIZE)
+    , nextInput(1)
+    , lastProcessed(0)
+    , reconciled(SnapshotCodec::NO_BASELINE)
+    , accumulator(0)
+    , predicting(false)
+    , correction(0, 0)
+{
+    // Intentionally left empty.
+}
+
+void PredictionService::OnStartup()
+{
+    client = GetSM().FindService<ReplicationClient>();
+    interpolation = GetSM().FindService<InterpolationService>();
+    if (!client || !interpolation) {
+        throw std::logic_error("Prediction requires a replication client and interpolation");
+    }
+
+    nextInput = 1;
+    lastProcessed = 0;
+    reconciled = SnapshotCodec::NO_BASELINE;
+    accumulator = 0;
+    predicting = false;
+    correction.Set(0, 0);
+}
+
+void PredictionService::OnShutdown()
+{
+    client = nullptr;
+    interpolation = nullptr;
+}
+
+void PredictionService::OnUpdate()
+{
+    if (!client->IsConnected()) {
+        return;
+    }
+
+    const auto & info = client->GetClientInfo();
+    if (client->GetLatestSequence() != reconciled) {
+        reconciled = client->GetLatestSequence();
+        Reconcile(info);
+    }
+
+    const double dt = GetSM().GetService<ITimeService>().GetElapsedTime();
+    if (SampleInputs(dt, info)) {
+        SendPendingInputs();
+    }
+
+    // Show the player at the predicted pose, fading out corrections.
+    correction *= std::exp(-CORRECTION_RATE * dt);
+    auto player = interpolation->FindEntity(info.playerId);
+    if (player) {
+        auto & pose = player->GetComponent<Pose2D>();
+        pose.pos = predicted.pos + correction;
+        pose.angle = predicted.angle;
+    }
+}
+
+void PredictionService::Reconcile(const ClientInfo & info)
+{
+    lastProcessed = std::max(lastProcessed, info.lastInput);
+    nextInput = std::max(nextInput, lastProcessed + 1);
+
+    Pose2D authoritative(
+        SnapshotCodec::DequantizePosition(info.playerX), 
+        SnapshotCodec::DequantizePosition(info.playerY), 
+        SnapshotCodec::DequantizeAngle(info.playerAngle));
+
+    // Replay the inputs the server has not processed yet.
+    const double tickDt = 1.0 / info.tickRate;
+    for (uint32_t seq = lastProcessed + 1; seq < nextInput; ++seq) {
+        PlayerMovement::Step(authoritative, inputs[seq % INPUT_BUFFER_SIZE], tickDt);
+    }
+
+    if (predicting) {
+        correction += predicted.pos - authoritative.pos;
+        if (correction.LengthSquared() > MAX_CORRECTION * MAX_CORRECTION) {
+            correction.Set(0, 0);
+        }
+    }
+    predicted.pos = authoritative.pos;
+    predicted.angle = authoritative.angle;
+    predicting = true;
+}
+
+bool PredictionService::SampleInputs(double dt, const ClientInfo & info)
+{
+    const double tickDt = 1.0 / info.tickRate;
+    const uint32_t first = nextInput;
+
+    Mouse mouse;
+    PlayerInput input;
+    input.targetX = SnapshotCodec::QuantizePosition(mouse.GetCursorX());
+    input.targetY = SnapshotCodec::QuantizePosition(mouse.GetCursorY());
+
+    accumulator += dt;
+    while (accumulator >= tickDt) {
+        // Stop predicting if the server falls too far behind.
+        if (nextInput - lastProcessed >= INPUT_BUFFER_SIZE) {
+            accumulator = 0;
+            break;
+        }
+
+        accumulator -= tickDt;
+        inputs[nextInput % INPUT_BUFFER_SIZE] = input;
+        PlayerMovement::Step(predicted, input, tickDt);
+        ++nextInput;
+    }
+
+    return nextInput != first;
+}
+
+void PredictionService::SendPendingInputs()
+{
+    // Resend unprocessed inputs, in case earlier messages got lost.
+    uint32_t first = std::max(lastProcessed + 1, 
+        nextInput - static_cast<uint32_t>(std::min<size_t>(nextInput - 1, NetProtocol::MAX_INPUTS_PER_MESSAGE)));
+
+    PlayerInput pending[NetProtocol::MAX_INPUTS_PER_MESSAGE];
+    size_t count = 0;
+    for (uint32_t seq = first; seq < nextInput; ++seq) {
+        pending[count++] = inputs[seq % INPUT_BUFFER_SIZE];
+    }
+    client->SendInputs(first, pending, count);
+}
@@ -0,0 +1,103 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <UpdateService.h>
+#include <Vector2.h>
+
+#include "ReplicationClient.h"
+#include "InterpolationService.h"
+#include "PlayerMovement.h"
+#include "Pose2D.h"
+
+/**
+ * Predicts the movement of the player entity controlled by the mouse.
+ * 
+ * The mouse cursor is sampled once per server tick and the resulting input
+ * is applied locally right away, instead of waiting for the server. Inputs
+ * are kept until the server has processed them. Whenever a snapshot arrives,
+ * the prediction restarts from the authoritative state of the player and
+ * replays the pending inputs. Remaining prediction errors are smoothed out
+ * over a couple of frames. This service should be updated after the 
+ * interpolation service.
+ */
+class PredictionService : public astu::UpdatableBaseService {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param priority  the update priority of this service
+     */
+    PredictionService(int priority = 0);
+
+protected:
+
+    // Inherited via UpdatableBaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+    virtual void OnUpdate() override;
+
+private:
+    /** The replication client used to exchange inputs and states. */
+    std::shared_ptr<ReplicationClient> client;
+
+    /** The interpolation service mirroring the player entity. */
+    std::shared_ptr<InterpolationService> interpolation;
+
+    /** The inputs not yet processed by the server, indexed by sequence number. */
+    std::vector<PlayerInput> inputs;
+
+    /** The sequence number of the next input. */
+    uint32_t nextInput;
+
+    /** The sequence number of the last input processed by the server. */
+    uint32_t lastProcessed;
+
+    /** The sequence number of the snapshot the prediction is based on. */
+    uint32_t reconciled;
+
+    /** The time not yet covered by inputs. */
+    double accumulator;
+
+    /** Whether the prediction has been initialized with a server state. */
+    bool predicting;
+
+    /** The predicted pose of the player. */
+    Pose2D predicted;
+
+    /** The offset between the shown and the predicted position. */
+    astu::Vector2<double> correction;
+
+    /**
+     * Restarts the prediction from the state reported by the server.
+     * 
+     * @param info  the client information of the latest snapshot
+     */
+    void Reconcile(const ClientInfo & info);
+
+    /**
+     * Samples the mouse cursor once per elapsed server tick.
+     * 
+     * @param dt    the elapsed time since the last frame
+     * @param info  the client information of the latest snapshot
+     * @return `true` if new inputs have been sampled
+     */
+    bool SampleInputs(double dt, const ClientInfo & info);
+
+    /**
+     * Sends the inputs not yet processed by the server.
+     */
+    void SendPendingInputs();
+};
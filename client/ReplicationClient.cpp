@@ -0,0 +1,165 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <cassert>
+#include <iostream>
+#include "ReplicationClient.h"
+
+#define HISTORY_SIZE 32
+#define HELLO_INTERVAL std::chrono::seconds(1)
+#define SNAPSHOT_TIMEOUT std::chrono::seconds(3)
+
+using namespace astu;
+
+ReplicationClient::ReplicationClient(const NetAddress & server, int priority)
+    : UpdatableBaseService("Replication Client", priority)
+    , server(server)
+    , latest(SnapshotCodec::NO_BASELINE)
+    , clientInfo()
+    , history(HISTORY_SIZE)
+    , packet(NetProtocol::MAX_PACKET_SIZE)
+    , receiveBuffer(NetProtocol::MAX_PACKET_SIZE)
+{
+    // Intentionally left empty.
+}
+
+void ReplicationClient::OnStartup()
+{
+    socket = std::make_unique<UdpSocket>();
+    ResetConnection();
+    SendEmptyMessage(MessageType::HELLO);
+    lastHello = Clock::now();
+}
+
+void ReplicationClient::OnShutdown()
+{
+    SendEmptyMessage(MessageType::BYE);
+    socket = nullptr;
+    ResetConnection();
+}
+
+void ReplicationClient::OnUpdate()
+{
+    // The server has dropped this client or has been restarted, in the 
+    // latter case its snapshots start over at sequence number one.
+    if (IsConnected() && Clock::now() - lastSnapshot >= SNAPSHOT_TIMEOUT) {
+        std::cerr << "no snapshots received, reconnecting" << std::endl;
+        ResetConnection();
+        lastHello = Clock::now() - HELLO_INTERVAL;
+    }
+
+    // Keep knocking until the server responds.
+    if (!IsConnected() && Clock::now() - lastHello >= HELLO_INTERVAL) {
+        SendEmptyMessage(MessageType::HELLO);
+        lastHello = Clock::now();
+    }
+
+    ReceiveMessages();
+}
+
+const Snapshot* ReplicationClient::GetSnapshot(uint32_t sequence) const
+{
+    const auto & snapshot = history[sequence % HISTORY_SIZE];
+    return sequence != SnapshotCodec::NO_BASELINE && snapshot.sequence == sequence ? &snapshot : nullptr;
+}
+
+void ReplicationClient::ResetConnection()
+{
+    latest = SnapshotCodec::NO_BASELINE;
+    clientInfo = ClientInfo();
+    for (auto & snapshot : history) {
+        snapshot.sequence = SnapshotCodec::NO_BASELINE;
+        snapshot.entities.clear();
+    }
+}
+
+void ReplicationClient::ReceiveMessages()
+{
+    NetAddress from;
+    size_t size;
+    bool updated = false;
+    while ((size = socket->Receive(from, receiveBuffer.data(), receiveBuffer.size())) > 0) {
+        InputBuffer in(receiveBuffer.data(), size);
+        MessageType type;
+        if (from != server || !NetProtocol::ReadHeader(in, type) || type != MessageType::SNAPSHOT) {
+            continue;
+        }
+
+        ClientInfo info;
+        if (info.Read(in) && ReceiveSnapshot(in)) {
+            clientInfo = info;
+            updated = true;
+        }
+    }
+
+    // Acknowledge only the latest of the received snapshots.
+    if (updated) {
+        SendAck();
+    }
+}
+
+bool ReplicationClient::ReceiveSnapshot(InputBuffer & in)
+{
+    uint32_t sequence, baselineSequence;
+    if (!SnapshotCodec::DecodeHeader(in, sequence, baselineSequence) || sequence <= latest) {
+        return false;
+    }
+
+    const Snapshot* baseline = &emptySnapshot;
+    if (baselineSequence != SnapshotCodec::NO_BASELINE) {
+        baseline = GetSnapshot(baselineSequence);
+        if (!baseline) {
+            // The baseline is no longer available, wait for a newer snapshot.
+            return false;
+        }
+    }
+
+    if (!SnapshotCodec::Decode(in, sequence, *baseline, decoded)) {
+        std::cerr << "dropped malformed snapshot " << sequence << std::endl;
+        return false;
+    }
+
+    // The decoded snapshot may replace its own baseline within the history.
+    std::swap(history[sequence % HISTORY_SIZE], decoded);
+    latest = sequence;
+    lastSnapshot = Clock::now();
+    return true;
+}
+
+void ReplicationClient::SendInputs(uint32_t first, const PlayerInput* inputs, size_t count)
+{
+    assert(count <= NetProtocol::MAX_INPUTS_PER_MESSAGE);
+
+    packet.Clear();
+    NetProtocol::WriteHeader(packet, MessageType::INPUT);
+    packet.WriteUInt32(first);
+    packet.WriteUInt8(static_cast<uint8_t>(count));
+    for (size_t i = 0; i < count; ++i) {
+        packet.WriteVarInt(inputs[i].targetX);
+        packet.WriteVarInt(inputs[i].targetY);
+    }
+    socket->Send(server, packet.GetData(), packet.GetSize());
+}
+
+void ReplicationClient::SendEmptyMessage(MessageType type)
+{
+    packet.Clear();
+    NetProtocol::WriteHeader(packet, type);
+    socket->Send(server, packet.GetData(), packet.GetSize());
+}
+
+void ReplicationClient::SendAck()
+{
+    packet.Clear();
+    NetProtocol::WriteHeader(packet, MessageType::ACK);
+    packet.WriteUInt32(latest);
+    socket->Send(server, packet.GetData(), packet.GetSize());
+}
@@ -0,0 +1,165 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <UpdateService.h>
+
+#include "UdpSocket.h"
+#include "NetBuffer.h"
+#include "NetProtocol.h"
+#include "Snapshot.h"
+#include "PlayerMovement.h"
+
+/**
+ * Receives snapshots from the server and sends player inputs.
+ * 
+ * Received snapshots are kept for a while, since the server encodes
+ * snapshots relative to the latest one acknowledged by the client, and
+ * since the interpolation renders entities between buffered snapshots.
+ * This service should be updated before the services using the snapshots.
+ * 
+ * If no snapshot has been accepted for a while, e.g., because the server
+ * has dropped the client or has been restarted, the received snapshots
+ * are discarded and the client says HELLO again.
+ */
+class ReplicationClient : public astu::UpdatableBaseService {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param server    the address of the server
+     * @param priority  the update priority of this service
+     */
+    ReplicationClient(const NetAddress & server, int priority = 0);
+
+    /**
+     * Tests whether snapshots have been received from the server.
+     * 
+     * @return `true` if connected to the server
+     */
+    bool IsConnected() const {
+        return latest != SnapshotCodec::NO_BASELINE;
+    }
+
+    /**
+     * Returns the sequence number of the latest received snapshot.
+     * 
+     * @return the sequence number, SnapshotCodec::NO_BASELINE if none
+     */
+    uint32_t GetLatestSequence() const {
+        return latest;
+    }
+
+    /**
+     * Returns a received snapshot.
+     * 
+     * @param sequence  the sequence number of the snapshot
+     * @return the snapshot or null if not received or no longer available
+     */
+    const Snapshot* GetSnapshot(uint32_t sequence) const;
+
+    /**
+     * Returns the client information sent along with the latest snapshot.
+     * 
+     * @return the client information
+     */
+    const ClientInfo & GetClientInfo() const {
+        return clientInfo;
+    }
+
+    /**
+     * Sends player inputs to the server.
+     * 
+     * @param first     the sequence number of the first input
+     * @param inputs    the inputs to send
+     * @param count     the number of inputs, at most MAX_INPUTS_PER_MESSAGE
+     */
+    void SendInputs(uint32_t first, const PlayerInput* inputs, size_t count);
+
+protected:
+
+    // Inherited via UpdatableBaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+    virtual void OnUpdate() override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /** The address of the server. */
+    NetAddress server;
+
+    /** The socket used to communicate with the server. */
+    std::unique_ptr<UdpSocket> socket;
+
+    /** The sequence number of the latest received snapshot. */
+    uint32_t latest;
+
+    /** The client information sent along with the latest snapshot. */
+    ClientInfo clientInfo;
+
+    /** The point in time the last HELLO message has been sent. */
+    Clock::time_point lastHello;
+
+    /** The point in time the latest snapshot has been accepted. */
+    Clock::time_point lastSnapshot;
+
+    /** The recently received snapshots, indexed by sequence number. */
+    std::vector<Snapshot> history;
+
+    /** Used as baseline for snapshots encoded against no snapshot. */
+    Snapshot emptySnapshot;
+
+    /** Receives decoded snapshots. */
+    Snapshot decoded;
+
+    /** Used to assemble outgoing datagrams. */
+    OutputBuffer packet;
+
+    /** Receives incoming datagrams. */
+    std::vector<uint8_t> receiveBuffer;
+
+    /**
+     * Discards all received snapshots, the client is no longer connected
+     * afterwards.
+     */
+    void ResetConnection();
+
+    /**
+     * Handles all pending datagrams.
+     */
+    void ReceiveMessages();
+
+    /**
+     * Decodes a snapshot and stores it in the history.
+     * 
+     * @param in    the encoded snapshot, following the client information
+     * @return `true` if the snapshot is newer than all snapshots received so far
+     */
+    bool ReceiveSnapshot(InputBuffer & in);
+
+    /**
+     * Sends a message without payload to the server.
+     * 
+     * @param type  the type of the message
+     */
+    void SendEmptyMessage(MessageType type);
+
+    /**
+     * Acknowledges the latest received snapshot.
+     */
+    void SendAck();
+};
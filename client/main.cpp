@@ -11,6 +11,7 @@
 
 #include <iostream>
 #include <string>
+#include <cstdlib>
 
 #include <ServiceManager.h>
 #include <UpdateService.h>
@@ -20,15 +21,16 @@
 #include <SdlVideoService.h>
 #include <SdlRenderService.h>
 #include <SdlTimeService.h>
-#include <SdlAudioService.h>
 
 #include <EntityService.h>
 
 #include "SdlLineRenderer.h"
+#include "PolylineVisualSystem.h"
+#include "ReplicationClient.h"
+#include "InterpolationService.h"
+#include "PredictionService.h"
+#include "NetProtocol.h"
 #include "Pose2D.h"
-#include "CommandQueue.h"
-#include "ListenerManager.h"
-#include "SignalService.h"
 
 using namespace std;
 using namespace astu;
@@ -36,8 +38,15 @@ using namespace astu;
 const std::string kAppName = "Bagaga Client";
 const std::string kAppVersion = "0.1.0";
 
-int main()
+int main(int argc, char* argv[])
 {
+	std::string host = argc > 1 ? argv[1] : "127.0.0.1";
+	int port = argc > 2 ? std::atoi(argv[2]) : NetProtocol::DEFAULT_PORT;
+	if (port <= 0 || port > 65535) {
+		std::cerr << "usage: " << argv[0] << " [server address] [port]" << std::endl;
+		return -1;
+	}
+
 	auto &sm = ServiceManager::GetInstance();
 	sm.AddService(std::make_shared<UpdateService>());
 
@@ -49,9 +58,18 @@ int main()
 
 	sm.AddService(std::make_shared<SdlLineRenderer>(0));
 
-	// configure application
+	// Mirror the entities replicated by the server, the player entity 
+	// follows the mouse cursor.
+	sm.AddService(std::make_shared<EntityService>());
+	sm.AddService(std::make_shared<ReplicationClient>(
+		NetAddress::Parse(host, static_cast<uint16_t>(port))));
+	sm.AddService(std::make_shared<InterpolationService>());
+	sm.AddService(std::make_shared<PredictionService>());
+	sm.AddService(std::make_shared<PolylineVisualSystem>());
+
+	// configure application, the window matches the size of the server's world
 	sm.GetService<IWindowManager>().SetTitle(kAppName + " - Version " + kAppVersion);
-	sm.GetService<IWindowManager>().SetSize(640, 480);
+	sm.GetService<IWindowManager>().SetSize(1280, 720);
 
 	// start game loop
 	sm.StartupAll();
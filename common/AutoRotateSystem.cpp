@@ -9,8 +9,6 @@
  * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
  */
 
-#include <stdexcept>
-#include <cassert>
 #include "Pose2D.h"
 #include "AutoRotate.h"
 #include "AutoRotateSystem.h"
@@ -20,26 +18,35 @@ using namespace astu;
 const EntityFamily AutoRotateSystem::FAMILY = EntityFamily::Create<Pose2D, AutoRotate>();
 
 AutoRotateSystem::AutoRotateSystem(int priority)
-    : IteratingEntitySystem(FAMILY, priority, "AutoRotate System")
+    : BatchEntitySystem(
+        FAMILY, 
+        ComponentAccess(
+            ComponentAccess::ROTATION_SPEED | ComponentAccess::ORIENTATION, 
+            ComponentAccess::ORIENTATION), 
+        priority, 
+        "AutoRotate System")
 {
     // Intentionally left empty.
 }
 
-void AutoRotateSystem::OnStartup()
+void AutoRotateSystem::ProcessEntities(const EntityView & view, size_t begin, size_t end, double dt)
 {
-    // Intentionally left empty.
-}
+    for (size_t i = begin; i < end; ++i) {
+        auto & e = *view[i];
+        auto & pose = e.GetComponent<Pose2D>();
+        auto & rotate = e.GetComponent<AutoRotate>();
 
-void AutoRotateSystem::OnShutdown()
-{
-    // Intentionally left empty.
+        pose.angle += rotate.speed * dt;
+    }
 }
 
-
-void AutoRotateSystem::ProcessEntity(Entity & e)
+void AutoRotateSystem::ProcessStore(SoaComponentStore & store, size_t begin, size_t end, double dt)
 {
-    auto & pose = e.GetComponent<Pose2D>();
-    auto & rotate = e.GetComponent<AutoRotate>();
+    // Slots without auto rotation have zero speed, no need to check flags.
+    double* angle = store.angle.data();
+    const double* speed = store.rotSpeed.data();
 
-    pose.angle += rotate.speed * GetDeltaTime();
+    for (size_t i = begin; i < end; ++i) {
+        angle[i] += speed[i] * dt;
+    }
 }
@@ -11,10 +11,9 @@
 
 #pragma once
 
-#include <IteratingEntitySystem.h>
-#include "ILineRenderer.h"
+#include "BatchEntitySystem.h"
 
-class AutoRotateSystem : public astu::IteratingEntitySystem {
+class AutoRotateSystem : public BatchEntitySystem {
 public:
 
     /**
@@ -26,12 +25,11 @@ public:
 
 protected:
 
-    // Inherited via IteratingEntitySystem
-    virtual void OnStartup() override;
-    virtual void OnShutdown() override;
-    virtual void ProcessEntity(astu::Entity & e) override;
+    // Inherited via BatchEntitySystem
+    virtual void ProcessEntities(const astu::EntityView & view, size_t begin, size_t end, double dt) override;
+    virtual void ProcessStore(SoaComponentStore & store, size_t begin, size_t end, double dt) override;
 
 private:
     /** A constant describing the family of entities this system processes. */
     static const astu::EntityFamily FAMILY;
-};
\ No newline at end of file
+};
@@ -0,0 +1,99 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <stdexcept>
+#include "FrameProfiler.h"
+#include "BatchEntitySystem.h"
+
+#define GRAIN_SIZE 2048
+
+using namespace astu;
+
+BatchEntitySystem::BatchEntitySystem(
+    const EntityFamily & f, 
+    const ComponentAccess & a, 
+    int priority, 
+    const std::string & name)
+    : UpdatableBaseService(name, priority)
+    , family(f)
+    , access(a)
+    , grouped(false)
+    , batchName(name + " Batch")
+{
+    // Intentionally left empty.
+}
+
+void BatchEntitySystem::OnStartup()
+{
+    entityView = GetSM().GetService<EntityService>().GetEntityView(family);
+    store = GetSM().FindService<SoaComponentStore>();
+    jobSystem = GetSM().FindService<JobSystem>();
+
+    timeService = GetSM().FindService<ITimeService>();
+    if (!timeService) {
+        throw std::logic_error("Time service required for " + GetName());
+    }
+}
+
+void BatchEntitySystem::OnShutdown()
+{
+    entityView = nullptr;
+    store = nullptr;
+    timeService = nullptr;
+    jobSystem = nullptr;
+}
+
+void BatchEntitySystem::OnUpdate()
+{
+    // Grouped systems are executed by their group.
+    if (!grouped && !IsStepped()) {
+        Execute(timeService->GetElapsedTime());
+    }
+}
+
+void BatchEntitySystem::OnFixedStep(double dt)
+{
+    if (!grouped) {
+        Execute(dt);
+    }
+}
+
+void BatchEntitySystem::Execute(double dt)
+{
+    BAGAGA_PROFILE_SCOPE_COUNT(GetName().c_str(), entityView->size() + (store ? store->Size() : 0));
+
+    if (!jobSystem) {
+        ProcessEntities(*entityView, 0, entityView->size(), dt);
+        if (store) {
+            ProcessStore(*store, 0, store->Size(), dt);
+        }
+        return;
+    }
+
+    const EntityView & view = *entityView;
+    jobSystem->ParallelFor(view.size(), GRAIN_SIZE, [this, &view, dt](size_t begin, size_t end) {
+        BAGAGA_PROFILE_SCOPE_COUNT(batchName.c_str(), end - begin);
+        ProcessEntities(view, begin, end, dt);
+    });
+
+    if (store) {
+        SoaComponentStore & s = *store;
+        jobSystem->ParallelFor(s.Size(), GRAIN_SIZE, [this, &s, dt](size_t begin, size_t end) {
+            BAGAGA_PROFILE_SCOPE_COUNT(batchName.c_str(), end - begin);
+            ProcessStore(s, begin, end, dt);
+        });
+    }
+}
+
+void BatchEntitySystem::ProcessStore(SoaComponentStore & store, size_t begin, size_t end, double dt)
+{
+    // Intentionally left empty.
+}
@@ -0,0 +1,138 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <string>
+#include <UpdateService.h>
+#include <EntityService.h>
+#include <ITimeService.h>
+#include "SoaComponentStore.h"
+#include "ComponentAccess.h"
+#include "JobSystem.h"
+#include "FixedStepSystem.h"
+
+/**
+ * Base class for systems processing a family of entities in batches.
+ * 
+ * Instead of one virtual call per entity, derived systems receive all
+ * entities of their family in a single call. Entities kept in the dense
+ * component store are handed over as whole arrays in a second call.
+ * 
+ * Only the dense store avoids the component lookups: the entity service
+ * keeps components per entity, hence ProcessEntities still has to fetch
+ * the components of each entity. Hot entities should therefore be kept
+ * in the dense store.
+ * 
+ * If a JobSystem is available, the entities are split into chunks which
+ * are processed in parallel. Derived systems must therefore process each
+ * entity independently of the others and touch only the component data
+ * they declare in their component access.
+ * 
+ * Batch entity systems can be stepped by a FixedStepService, otherwise
+ * they advance by the elapsed time of the time service once per frame.
+ * 
+ * Derived systems overriding OnStartup or OnShutdown must call the
+ * implementation of this base class.
+ */
+class BatchEntitySystem : public astu::UpdatableBaseService, public FixedStepSystem {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param family    the family of entities this system processes
+     * @param access    the component data this system reads and writes
+     * @param priority  the update priority of this service
+     * @param name      the name of this service
+     */
+    BatchEntitySystem(
+        const astu::EntityFamily & family, 
+        const ComponentAccess & access,
+        int priority = 0, 
+        const std::string & name = "Batch Entity System");
+
+    /**
+     * Returns the component data this system reads and writes.
+     * 
+     * @return the component access of this system
+     */
+    const ComponentAccess & GetComponentAccess() const {
+        return access;
+    }
+
+protected:
+
+    // Inherited via UpdatableBaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+    virtual void OnUpdate() override final;
+
+    // Inherited via FixedStepSystem
+    virtual void OnFixedStep(double dt) override final;
+
+    /**
+     * Processes a range of the entities of the family of this system.
+     * Might be called concurrently for disjoint ranges.
+     * 
+     * @param view  the entities of the family
+     * @param begin the index of the first entity to process
+     * @param end   the index one past the last entity to process
+     * @param dt    the elapsed time in seconds
+     */
+    virtual void ProcessEntities(const astu::EntityView & view, size_t begin, size_t end, double dt) = 0;
+
+    /**
+     * Processes a range of the slots of the dense component store.
+     * Called only if a store is available, does nothing by default.
+     * Might be called concurrently for disjoint ranges.
+     * 
+     * @param store the dense component store
+     * @param begin the index of the first slot to process
+     * @param end   the index one past the last slot to process
+     * @param dt    the elapsed time in seconds
+     */
+    virtual void ProcessStore(SoaComponentStore & store, size_t begin, size_t end, double dt);
+
+private:
+    /** The family of entities this system processes. */
+    astu::EntityFamily family;
+
+    /** The component data this system reads and writes. */
+    ComponentAccess access;
+
+    /** Whether this system is executed by a parallel system group. */
+    bool grouped;
+
+    /** The name of the batches of this system used by the profiler. */
+    std::string batchName;
+
+    /** The view to the entities to be processed. */
+    std::shared_ptr<astu::EntityView> entityView;
+
+    /** The optional dense component store, processed in addition to the view. */
+    std::shared_ptr<SoaComponentStore> store;
+
+    /** Used for fast access to time service. */
+    std::shared_ptr<astu::ITimeService> timeService;
+
+    /** The optional job system used to process chunks in parallel. */
+    std::shared_ptr<JobSystem> jobSystem;
+
+    /**
+     * Processes all entities of the family of this system.
+     * 
+     * @param dt    the elapsed time in seconds
+     */
+    void Execute(double dt);
+
+    friend class ParallelSystemGroup;
+};
@@ -14,18 +14,34 @@
 #include <EntityService.h>
 #include <Vector2.h>
 
+#include <cstdint>
+
 class CircleCollider : public astu::EntityComponent {
 public:
     /** The radius of the circle collider. */
     double radius;
 
+    /** The collision layers this collider belongs to, one bit per layer. */
+    uint32_t category;
+
+    /** The collision layers this collider collides with, one bit per layer. */
+    uint32_t mask;
+
     /**
      * Constructor.
      * 
-     * @param r the radius
+     * Two colliders collide only if the category of each collider
+     * intersects the mask of the other one. By default, colliders belong
+     * to the first layer and collide with all layers.
+     * 
+     * @param r     the radius
+     * @param cat   the collision layers this collider belongs to
+     * @param msk   the collision layers this collider collides with
      */
-    CircleCollider(double r = 1.0)
+    CircleCollider(double r = 1.0, uint32_t cat = 0x1, uint32_t msk = 0xffffffff)
         : radius(r)
+        , category(cat)
+        , mask(msk)
     {
         // Intentionally left empty.
     }
@@ -1,16 +1,26 @@
 #include <stdexcept>
+#include <algorithm>
+#include <cmath>
 #include <EntityService.h>
 #include <Vector2.h>
 #include <iostream>
 
 #include "Pose2D.h"
 #include "CircleCollider.h"
+#include "FrameProfiler.h"
 #include "CollisionDetectionSystem.h"
 
+#define GRAIN_SIZE 1024
+
 using namespace astu;
 
-CollisionDetectionSystem::CollisionDetectionSystem(int priority)
+CollisionDetectionSystem::CollisionDetectionSystem(BroadPhase mode, int priority)
     : UpdatableBaseService("Collision Detection", priority)
+    , broadPhase(mode)
+    , pairStamp(0)
+    , maxRadius(0)
+    , grid(1.0)
+    , sapStamp(0)
 {
     // Intentionally left empty.
 }
@@ -21,50 +31,447 @@ void CollisionDetectionSystem::OnStartup()
     entityView = 
         es.GetEntityView(EntityFamily::Create<Pose2D, CircleCollider>());
 
-    collisionEventService = GetSM().FindService<CollisionEventService>();
-    if (!collisionEventService) {
-        throw std::logic_error("Collision detection systems requires collision event service");
+    store = GetSM().FindService<SoaComponentStore>();
+    if (store) {
+        denseView = es.GetEntityView(EntityFamily::Create<DenseSlot>());
     }
+
+    jobSystem = GetSM().FindService<JobSystem>();
 }
 
 void CollisionDetectionSystem::OnShutdown()
 {
-    collisionEventService = nullptr;
+    listeners.clear();
+    jobSystem = nullptr;
     entityView = nullptr;    
+    denseView = nullptr;
+    store = nullptr;
+    proxies.clear();
+    grid.Clear();
+    cellFilters.clear();
+    sapLookup.clear();
+    sapHandles.clear();
+    sapFreeHandles.clear();
+    sapIntervals.clear();
+    chunkPairs.clear();
+    contacts.clear();
+    for (auto & c : stateContacts) {
+        c.clear();
+    }
+    pairCache.clear();
+    endedEntities.clear();
+}
+
+void CollisionDetectionSystem::AddListener(std::shared_ptr<ICollisionListener> listener)
+{
+    listeners.push_back(listener);
+}
+
+void CollisionDetectionSystem::RemoveListener(std::shared_ptr<ICollisionListener> listener)
+{
+    listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
 }
 
 void CollisionDetectionSystem::OnUpdate()
 {
-    for (size_t j = 0; j < entityView->size(); ++j) {
-        const auto & entityA = (*entityView)[j];
+    if (!IsStepped()) {
+        Detect();
+    }
+}
+
+void CollisionDetectionSystem::OnFixedStep(double dt)
+{
+    Detect();
+}
+
+void CollisionDetectionSystem::Detect()
+{
+    BAGAGA_PROFILE_SCOPE(GetName().c_str());
+    GatherProxies();
+    BuildBroadPhase();
+
+    // Split the pair search into chunks, each with its own buffer.
+    const size_t n = proxies.size();
+    const size_t numChunks = (n + GRAIN_SIZE - 1) / GRAIN_SIZE;
+    if (chunkPairs.size() < numChunks) {
+        chunkPairs.resize(numChunks);
+    }
+    for (size_t i = 0; i < numChunks; ++i) {
+        chunkPairs[i].clear();
+    }
+
+    auto detect = [this](size_t begin, size_t end) {
+        BAGAGA_PROFILE_SCOPE_COUNT("Narrow Phase Batch", end - begin);
+        DetectPairs(begin, end, chunkPairs[begin / GRAIN_SIZE]);
+    };
+
+    if (jobSystem) {
+        jobSystem->ParallelFor(n, GRAIN_SIZE, detect);
+    } else {
+        for (size_t begin = 0; begin < n; begin += GRAIN_SIZE) {
+            detect(begin, std::min(n, begin + GRAIN_SIZE));
+        }
+    }
+
+    // Merge in chunk order, which matches the order of a serial search.
+    contacts.clear();
+    for (size_t i = 0; i < numChunks; ++i) {
+        contacts.insert(contacts.end(), chunkPairs[i].begin(), chunkPairs[i].end());
+    }
+
+    UpdatePairCache();
+    ReportContacts();
+}
+
+void CollisionDetectionSystem::BuildBroadPhase()
+{
+    BAGAGA_PROFILE_SCOPE_COUNT("Broad Phase", proxies.size());
+    switch (broadPhase) {
+    case BroadPhase::BRUTE_FORCE:
+        break;
+
+    case BroadPhase::UNIFORM_GRID:
+        BuildUniformGrid();
+        break;
+
+    case BroadPhase::SWEEP_AND_PRUNE:
+        SyncSapIntervals();
+        break;
+    }
+}
+
+void CollisionDetectionSystem::GatherProxies()
+{
+    BAGAGA_PROFILE_SCOPE_COUNT("Gather Proxies", entityView->size());
+
+    // Fetch components once per entity instead of once per tested pair.
+    proxies.resize(entityView->size());
+    maxRadius = 0;
+    for (size_t i = 0; i < entityView->size(); ++i) {
+        auto & entity = *(*entityView)[i];
+        auto & proxy = proxies[i];
+        proxy.pos = entity.GetComponent<Pose2D>().pos;
+        const auto & collider = entity.GetComponent<CircleCollider>();
+        proxy.radius = collider.radius;
+        proxy.category = collider.category;
+        proxy.mask = collider.mask;
+        proxy.entity = &(*entityView)[i];
+        maxRadius = std::max(maxRadius, proxy.radius);
+    }
+
+    if (!denseView) {
+        return;
+    }
+
+    for (size_t i = 0; i < denseView->size(); ++i) {
+        const size_t slot = (*denseView)[i]->GetComponent<DenseSlot>().GetSlot();
+        if (!(store->flags[slot] & SoaComponentStore::CIRCLE_COLLIDER)) {
+            continue;
+        }
+
+        Proxy proxy;
+        proxy.pos.Set(store->posX[slot], store->posY[slot]);
+        proxy.radius = store->radius[slot];
+        proxy.category = store->category[slot];
+        proxy.mask = store->mask[slot];
+        proxy.entity = &(*denseView)[i];
+        maxRadius = std::max(maxRadius, proxy.radius);
+        proxies.push_back(proxy);
+    }
+}
+
+void CollisionDetectionSystem::DetectPairs(size_t begin, size_t end, PairBuffer & out) const
+{
+    switch (broadPhase) {
+    case BroadPhase::BRUTE_FORCE:
+        DetectBruteForce(begin, end, out);
+        break;
 
-        for (size_t i = j + 1; i < entityView->size(); ++i) {
-            const auto & entityB = (*entityView)[i];
+    case BroadPhase::UNIFORM_GRID:
+        DetectUniformGrid(begin, end, out);
+        break;
 
-            if (IsColliding(*entityA, *entityB)) {
-                ReportCollision(entityA, entityB);
+    case BroadPhase::SWEEP_AND_PRUNE:
+        DetectSweepAndPrune(begin, end, out);
+        break;
+    }
+}
+
+void CollisionDetectionSystem::DetectBruteForce(size_t begin, size_t end, PairBuffer & out) const
+{
+    for (size_t j = begin; j < end; ++j) {
+        for (size_t i = j + 1; i < proxies.size(); ++i) {
+            TestPair(j, i, out);
+        }
+    }
+}
+
+void CollisionDetectionSystem::BuildUniformGrid()
+{
+    // Cells are as wide as the largest collider, hence two colliding
+    // circles are located either in the same or in adjacent cells.
+    grid.Reset(maxRadius > 0 ? 2 * maxRadius : 1.0);
+    for (size_t i = 0; i < proxies.size(); ++i) {
+        grid.Insert(static_cast<uint32_t>(i), proxies[i].pos.x, proxies[i].pos.y);
+    }
+    grid.Build();
+
+    cellFilters.resize(grid.GetNumEntries());
+    for (size_t i = 0; i < grid.GetNumEntries(); ) {
+        const auto & entry = grid.GetEntry(i);
+        const auto & cell = *grid.FindCell(entry.cx, entry.cy);
+        CellFilter filter = {0, 0};
+        for (size_t j = cell.begin; j < cell.end; ++j) {
+            const auto & proxy = proxies[grid.GetEntry(j).idx];
+            filter.categories |= proxy.category;
+            filter.masks |= proxy.mask;
+        }
+        cellFilters[cell.begin] = filter;
+        i = cell.end;
+    }
+}
+
+void CollisionDetectionSystem::DetectUniformGrid(size_t begin, size_t end, PairBuffer & out) const
+{
+    for (size_t i = begin; i < end; ++i) {
+        const auto & entry = grid.GetEntry(i);
+
+        // Remaining colliders within the same cell.
+        const auto & cell = *grid.FindCell(entry.cx, entry.cy);
+        for (size_t j = i + 1; j < cell.end; ++j) {
+            TestPair(entry.idx, grid.GetEntry(j).idx, out);
+        }
+
+        // Visit only half of the neighbours to report each pair once.
+        TestCellPairs(entry.idx, entry.cx + 1, entry.cy, out);
+        TestCellPairs(entry.idx, entry.cx - 1, entry.cy + 1, out);
+        TestCellPairs(entry.idx, entry.cx, entry.cy + 1, out);
+        TestCellPairs(entry.idx, entry.cx + 1, entry.cy + 1, out);
+    }
+}
+
+void CollisionDetectionSystem::TestCellPairs(size_t idx, int32_t cx, int32_t cy, PairBuffer & out) const
+{
+    const auto* cell = grid.FindCell(cx, cy);
+    if (!cell) {
+        return;
+    }
+
+    // Skip the whole cell if none of its colliders passes the layer filter.
+    const auto & filter = cellFilters[cell->begin];
+    const auto & proxy = proxies[idx];
+    if (!(proxy.category & filter.masks) || !(proxy.mask & filter.categories)) {
+        return;
+    }
+
+    for (size_t i = cell->begin; i < cell->end; ++i) {
+        TestPair(idx, grid.GetEntry(i).idx, out);
+    }
+}
+
+void CollisionDetectionSystem::DetectSweepAndPrune(size_t begin, size_t end, PairBuffer & out) const
+{
+    for (size_t i = begin; i < end; ++i) {
+        const auto & a = sapIntervals[i];
+        const size_t idxA = sapHandles[a.handle].idx;
+
+        for (size_t j = i + 1; j < sapIntervals.size() && sapIntervals[j].minX <= a.maxX; ++j) {
+            const size_t idxB = sapHandles[sapIntervals[j].handle].idx;
+            if (idxA < idxB) {
+                TestPair(idxA, idxB, out);
+            } else {
+                TestPair(idxB, idxA, out);
             }
         }
     }
 }
 
-bool CollisionDetectionSystem::IsColliding(astu::Entity & a, astu::Entity & b)
+void CollisionDetectionSystem::SyncSapIntervals()
 {
-    // Get components of entity A
-    auto & poseA = a.GetComponent<Pose2D>();
-    auto & colA = a.GetComponent<CircleCollider>();
+    ++sapStamp;
 
-    // Get components of entity B
-    auto & poseB = b.GetComponent<Pose2D>();
-    auto & colB = b.GetComponent<CircleCollider>();
+    // Mark entities still present and append intervals for new entities.
+    const size_t numKnown = sapIntervals.size();
+    for (size_t i = 0; i < proxies.size(); ++i) {
+        Entity* entity = proxies[i].entity->get();
 
-    Vector2<double> d = poseA.pos - poseB.pos;
+        auto it = sapLookup.find(entity);
+        if (it == sapLookup.end()) {
+            size_t handle;
+            if (sapFreeHandles.empty()) {
+                handle = sapHandles.size();
+                sapHandles.push_back(SapHandle());
+            } else {
+                handle = sapFreeHandles.back();
+                sapFreeHandles.pop_back();
+            }
+            sapHandles[handle].entity = entity;
+            it = sapLookup.emplace(entity, handle).first;
+            sapIntervals.push_back({0, 0, handle});
+        }
+
+        auto & handle = sapHandles[it->second];
+        handle.idx = i;
+        handle.stamp = sapStamp;
+    }
+
+    // Drop intervals of removed entities, keeping the order of the others.
+    size_t numNew = sapIntervals.size() - numKnown;
+    size_t dst = 0;
+    for (size_t src = 0; src < sapIntervals.size(); ++src) {
+        auto & handle = sapHandles[sapIntervals[src].handle];
+        if (handle.stamp != sapStamp) {
+            sapLookup.erase(handle.entity);
+            sapFreeHandles.push_back(sapIntervals[src].handle);
+            continue;
+        }
+
+        auto & interval = sapIntervals[dst++];
+        interval = sapIntervals[src];
+        const auto & proxy = proxies[handle.idx];
+        interval.minX = proxy.pos.x - proxy.radius;
+        interval.maxX = proxy.pos.x + proxy.radius;
+    }
+    sapIntervals.resize(dst);
+    const auto firstNew = sapIntervals.end() - numNew;
 
-    double radiusSum = colA.radius+ colB.radius;
-    return d.LengthSquared() <= radiusSum * radiusSum;
+    // Entities move only a little from one frame to the next, so the known
+    // intervals are nearly sorted and insertion sort runs in almost linear time.
+    for (auto it = sapIntervals.begin(); it < firstNew; ++it) {
+        SapInterval interval = *it;
+        auto hole = it;
+        while (hole > sapIntervals.begin() && (hole - 1)->minX > interval.minX) {
+            *hole = *(hole - 1);
+            --hole;
+        }
+        *hole = interval;
+    }
+
+    // Sort newly added intervals separately and merge them in.
+    auto byMinX = [](const SapInterval & a, const SapInterval & b) {
+        return a.minX < b.minX;
+    };
+    std::sort(firstNew, sapIntervals.end(), byMinX);
+    std::inplace_merge(sapIntervals.begin(), firstNew, sapIntervals.end(), byMinX);
 }
 
-void CollisionDetectionSystem::ReportCollision(std::shared_ptr<astu::Entity> a, std::shared_ptr<astu::Entity> b)
+void CollisionDetectionSystem::TestPair(size_t idxA, size_t idxB, PairBuffer & out) const
 {
-    collisionEventService->QueueSignal(CollisionEvent(a, b));
+    const Proxy & a = proxies[idxA];
+    const Proxy & b = proxies[idxB];
+
+    // Layer filtering is far cheaper than the distance test, do it first.
+    if (!(a.category & b.mask) || !(b.category & a.mask)) {
+        return;
+    }
+
+    Vector2<double> d = b.pos - a.pos;
+
+    const double radiusSum = a.radius + b.radius;
+    const double distSquared = d.LengthSquared();
+    if (distSquared > radiusSum * radiusSum) {
+        return;
+    }
+
+    Contact contact;
+    contact.colliderA = static_cast<uint32_t>(idxA);
+    contact.colliderB = static_cast<uint32_t>(idxB);
+
+    // Concentric circles have no defined normal, any direction will do.
+    const double dist = std::sqrt(distSquared);
+    if (dist > 0) {
+        contact.normal.Set(d.x / dist, d.y / dist);
+    } else {
+        contact.normal.Set(1, 0);
+    }
+    contact.depth = radiusSum - dist;
+    contact.state = ContactState::BEGIN;
+    out.push_back(contact);
+}
+
+void CollisionDetectionSystem::UpdatePairCache()
+{
+    BAGAGA_PROFILE_SCOPE_COUNT("Pair Cache", contacts.size());
+    ++pairStamp;
+    for (auto & c : stateContacts) {
+        c.clear();
+    }
+    endedEntities.clear();
+
+    for (auto & contact : contacts) {
+        const auto & entityA = *proxies[contact.colliderA].entity;
+        const auto & entityB = *proxies[contact.colliderB].entity;
+        PairKey key = entityA.get() < entityB.get() 
+            ? PairKey(entityA.get(), entityB.get()) 
+            : PairKey(entityB.get(), entityA.get());
+
+        auto result = pairCache.emplace(key, CachedPair());
+        CachedPair & pair = result.first->second;
+        bool isNew = result.second;
+
+        // An expired entity has been removed and a new entity has taken its
+        // address, possible if entities do not share memory with their 
+        // control block. The pair of the removed entity has ended.
+        if (!isNew && (pair.entityA.expired() || pair.entityB.expired())) {
+            EndPair(pair);
+            isNew = true;
+        }
+
+        if (isNew) {
+            // Weak references are only taken once per pair.
+            pair.entityA = entityA;
+            pair.entityB = entityB;
+            contact.state = ContactState::BEGIN;
+        } else {
+            contact.state = ContactState::STAY;
+        }
+        pair.contact = contact;
+        pair.reversed = pair.entityA.owner_before(entityA) || entityA.owner_before(pair.entityA);
+        pair.stamp = pairStamp;
+        stateContacts[static_cast<size_t>(contact.state)].push_back(contact);
+    }
+
+    // Pairs not touching anymore, including those of removed entities.
+    for (auto it = pairCache.begin(); it != pairCache.end(); ) {
+        if (it->second.stamp == pairStamp) {
+            ++it;
+            continue;
+        }
+        EndPair(it->second);
+        it = pairCache.erase(it);
+    }
+}
+
+void CollisionDetectionSystem::EndPair(const CachedPair & pair)
+{
+    Contact contact = pair.contact;
+    contact.state = ContactState::END;
+    if (pair.reversed) {
+        contact.normal.Set(-contact.normal.x, -contact.normal.y);
+    }
+    contact.colliderA = static_cast<uint32_t>(endedEntities.size());
+    endedEntities.push_back(pair.entityA.lock());
+    contact.colliderB = static_cast<uint32_t>(endedEntities.size());
+    endedEntities.push_back(pair.entityB.lock());
+    stateContacts[static_cast<size_t>(ContactState::END)].push_back(contact);
+}
+
+void CollisionDetectionSystem::ReportContacts()
+{
+    BAGAGA_PROFILE_SCOPE("Report Contacts");
+    const auto & begin = GetContacts(ContactState::BEGIN);
+    const auto & stay = GetContacts(ContactState::STAY);
+    const auto & end = GetContacts(ContactState::END);
+
+    for (auto & listener : listeners) {
+        if (!begin.empty()) {
+            listener->OnContactsBegin(*this, begin);
+        }
+        if (!stay.empty()) {
+            listener->OnContactsStay(*this, stay);
+        }
+        if (!end.empty()) {
+            listener->OnContactsEnd(*this, end);
+        }
+    }
 }
@@ -1,54 +1,350 @@
 #pragma once
 
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
 #include <UpdateService.h>
 #include <EntityService.h>
-#include <SignalService.h>
 #include "CircleCollider.h"
+#include "SoaComponentStore.h"
+#include "JobSystem.h"
+#include "SpatialGrid.h"
+#include "FixedStepSystem.h"
 
 
-class CollisionEvent final {
+/** The state of a contact between two colliders. */
+enum class ContactState : uint8_t {
+    /** The colliders started touching within this frame. */
+    BEGIN,
+
+    /** The colliders have already been touching in the previous frame. */
+    STAY,
+
+    /** The colliders stopped touching or one of them has been removed. */
+    END,
+};
+
+/**
+ * A pair of touching colliders found by the collision detection system.
+ * 
+ * Colliders are referred to by handles valid within the current frame,
+ * use CollisionDetectionSystem::GetEntityA and GetEntityB to access the
+ * colliding entities.
+ */
+struct Contact {
+    /** The index of the first collider. */
+    uint32_t colliderA;
+
+    /** The index of the second collider. */
+    uint32_t colliderB;
+
+    /** The contact normal, pointing from the first to the second collider. */
+    astu::Vector2<double> normal;
+
+    /** The penetration depth, taken from the last frame of touching for ended contacts. */
+    double depth;
+
+    /** The state of this contact. */
+    ContactState state;
+};
+
+class CollisionDetectionSystem;
+
+/**
+ * Interface for receiving the contacts found by the collision detection.
+ */
+class ICollisionListener {
 public:
-    std::shared_ptr<astu::Entity> entityA;
-    std::shared_ptr<astu::Entity> entityB;
 
-    CollisionEvent(std::shared_ptr<astu::Entity> a, std::shared_ptr<astu::Entity> b)
-        : entityA(a), entityB(b)
-    {
+    /**
+     * Virtual Destructor.
+     */
+    virtual ~ICollisionListener() {}
+
+    /**
+     * Called once per frame in which colliders started touching.
+     * 
+     * Entities must not be removed from the entity service while the
+     * contacts are processed, use the EntityDestroyQueue instead. This 
+     * applies to all methods of this interface.
+     * 
+     * @param system    the collision detection system
+     * @param contacts  the new contacts of the current frame
+     */
+    virtual void OnContactsBegin(const CollisionDetectionSystem & system, const std::vector<Contact> & contacts) {
         // Intentionally left empty.
     }
 
-    astu::Entity & GetEntityA() const { 
-        return *entityA;
+    /**
+     * Called once per frame in which colliders keep touching.
+     * 
+     * @param system    the collision detection system
+     * @param contacts  the persisting contacts of the current frame
+     */
+    virtual void OnContactsStay(const CollisionDetectionSystem & system, const std::vector<Contact> & contacts) {
+        // Intentionally left empty.
     }
 
-    astu::Entity & GetEntityB() const {
-        return *entityB;
+    /**
+     * Called once per frame in which colliders stopped touching.
+     * 
+     * The entity of a collider which has been removed is `nullptr`.
+     * 
+     * @param system    the collision detection system
+     * @param contacts  the ended contacts of the current frame
+     */
+    virtual void OnContactsEnd(const CollisionDetectionSystem & system, const std::vector<Contact> & contacts) {
+        // Intentionally left empty.
     }
 };
 
-using CollisionEventService = astu::SignalService<CollisionEvent>;
-using CollisionListener = astu::ISignalListener<CollisionEvent>;
-
 
 class CollisionDetectionSystem : 
-    public astu::UpdatableBaseService
+    public astu::UpdatableBaseService,
+    public FixedStepSystem
 {
 public:
 
-    CollisionDetectionSystem(int priority = 0);
+    /** Enumeration of available broad phase strategies. */
+    enum class BroadPhase {
+        /** Tests every pair of colliders, used to verify the other strategies. */
+        BRUTE_FORCE,
+
+        /** Sorts colliders into a uniform grid sized after the largest collider. */
+        UNIFORM_GRID,
+
+        /** Sweeps along the x-axis, keeping the sorted intervals across frames. */
+        SWEEP_AND_PRUNE,
+    };
+
+    /**
+     * Constructor.
+     * 
+     * @param broadPhase    the broad phase strategy used to find candidate pairs
+     * @param priority      the update priority of this service
+     */
+    CollisionDetectionSystem(BroadPhase broadPhase = BroadPhase::UNIFORM_GRID, int priority = 0);
+
+    /**
+     * Adds a listener which receives the contacts of each frame.
+     * 
+     * @param listener  the listener to add
+     */
+    void AddListener(std::shared_ptr<ICollisionListener> listener);
+
+    /**
+     * Removes a listener.
+     * 
+     * @param listener  the listener to remove
+     */
+    void RemoveListener(std::shared_ptr<ICollisionListener> listener);
+
+    /**
+     * Returns the contacts of the current frame with a certain state.
+     * 
+     * @param state the state of the contacts
+     * @return the contacts
+     */
+    const std::vector<Contact> & GetContacts(ContactState state) const {
+        return stateContacts[static_cast<size_t>(state)];
+    }
+
+    /**
+     * Returns the entity of the first collider of a contact.
+     * 
+     * @param contact   the contact
+     * @return the entity owning the first collider
+     */
+    const std::shared_ptr<astu::Entity> & GetEntityA(const Contact & contact) const {
+        return GetEntity(contact, contact.colliderA);
+    }
+
+    /**
+     * Returns the entity of the second collider of a contact.
+     * 
+     * @param contact   the contact
+     * @return the entity owning the second collider
+     */
+    const std::shared_ptr<astu::Entity> & GetEntityB(const Contact & contact) const {
+        return GetEntity(contact, contact.colliderB);
+    }
 
 private:
+
+    /** Collider data gathered once per frame for the narrow phase. */
+    struct Proxy {
+        /** The position of the collider in world space. */
+        astu::Vector2<double> pos;
+
+        /** The radius of the collider. */
+        double radius;
+
+        /** The collision layers the collider belongs to. */
+        uint32_t category;
+
+        /** The collision layers the collider collides with. */
+        uint32_t mask;
+
+        /** The entity owning the collider, taken from one of the entity views. */
+        const std::shared_ptr<astu::Entity>* entity;
+    };
+
+    /** The layer filter of a grid cell. */
+    struct CellFilter {
+        /** The union of the collision categories of the colliders in this cell. */
+        uint32_t categories;
+
+        /** The union of the collision masks of the colliders in this cell. */
+        uint32_t masks;
+    };
+
+    /** Tracks an entity known to the sweep and prune broad phase. */
+    struct SapHandle {
+        /** The entity this handle refers to. */
+        astu::Entity* entity;
+
+        /** The index of the entity within the proxies of the current frame. */
+        size_t idx;
+
+        /** The frame in which the entity has last been seen. */
+        uint32_t stamp;
+    };
+
+    /** An interval along the x-axis, kept sorted by its lower bound. */
+    struct SapInterval {
+        /** The lower bound of the interval. */
+        double minX;
+
+        /** The upper bound of the interval. */
+        double maxX;
+
+        /** The handle of the entity this interval belongs to. */
+        size_t handle;
+    };
+
+    /** Contacts found by one chunk of the pair search. */
+    using PairBuffer = std::vector<Contact>;
+
+    /** 
+     * Identifies a pair of entities, ordered by their address. An address
+     * can be taken by a new entity once a removed entity has been released,
+     * which is detected by the expired weak references of the cached pair.
+     */
+    using PairKey = std::pair<const astu::Entity*, const astu::Entity*>;
+
+    /** Hash function for pair keys. */
+    struct PairKeyHash {
+        size_t operator()(const PairKey & key) const {
+            size_t h = std::hash<const astu::Entity*>()(key.first);
+            return h ^ (std::hash<const astu::Entity*>()(key.second) + 0x9e3779b9 + (h << 6) + (h >> 2));
+        }
+    };
+
+    /** A pair of touching entities, kept across frames. */
+    struct CachedPair {
+        /** The first entity. */
+        std::weak_ptr<astu::Entity> entityA;
+
+        /** The second entity. */
+        std::weak_ptr<astu::Entity> entityB;
+
+        /** The most recent contact of the pair. */
+        Contact contact;
+
+        /** Whether the most recent contact has the entities in reverse order. */
+        bool reversed;
+
+        /** The frame in which the pair has last been touching. */
+        uint32_t stamp;
+    };
+
+    /** The broad phase strategy used to find candidate pairs. */
+    BroadPhase broadPhase;
+
     /** The view to the entities to be processed. */
     std::shared_ptr<astu::EntityView> entityView;
 
-    /** Used to report collisions. */
-    std::shared_ptr<CollisionEventService> collisionEventService;
+    /** The view to the entities kept in the dense store, if any. */
+    std::shared_ptr<astu::EntityView> denseView;
+
+    /** The optional dense component store. */
+    std::shared_ptr<SoaComponentStore> store;
+
+    /** The optional job system used to test pairs in parallel. */
+    std::shared_ptr<JobSystem> jobSystem;
+
+    /** The listeners receiving the contacts. */
+    std::vector<std::shared_ptr<ICollisionListener>> listeners;
+
+    /** The touching contacts of the current frame, in the order of detection. */
+    std::vector<Contact> contacts;
+
+    /** The contacts of the current frame, by state. */
+    std::vector<Contact> stateContacts[3];
+
+    /** The touching pairs of the previous frame. */
+    std::unordered_map<PairKey, CachedPair, PairKeyHash> pairCache;
+
+    /** The entities of ended contacts, referred to by their handles. */
+    std::vector<std::shared_ptr<astu::Entity>> endedEntities;
+
+    /** Incremented every frame, used to detect ended contacts. */
+    uint32_t pairStamp;
+
+    /** The colliders of the current frame, in the order of the entity views. */
+    std::vector<Proxy> proxies;
+
+    /** The largest collider radius of the current frame. */
+    double maxRadius;
+
+    /** The colliders of the current frame, sorted into a uniform grid. */
+    SpatialGrid grid;
+
+    /** The layer filters of the grid cells, indexed by the first entry of each cell. */
+    std::vector<CellFilter> cellFilters;
+
+    /** Maps entities to their sweep and prune handles. */
+    std::unordered_map<astu::Entity*, size_t> sapLookup;
+
+    /** The handles of all entities known to the sweep and prune broad phase. */
+    std::vector<SapHandle> sapHandles;
+
+    /** Indices of unused sweep and prune handles. */
+    std::vector<size_t> sapFreeHandles;
+
+    /** The x-intervals of all colliders, sorted by their lower bounds. */
+    std::vector<SapInterval> sapIntervals;
+
+    /** Incremented every frame, used to detect removed entities. */
+    uint32_t sapStamp;
+
+    /** The colliding pairs found by each chunk of the pair search. */
+    std::vector<PairBuffer> chunkPairs;
 
     // Inherited via Base Service
     virtual void OnStartup() override;
     virtual void OnShutdown() override;
     virtual void OnUpdate() override;
 
-    bool IsColliding(astu::Entity & a, astu::Entity & b);
-    void ReportCollision(std::shared_ptr<astu::Entity> a, std::shared_ptr<astu::Entity> b);
-};
\ No newline at end of file
+    // Inherited via FixedStepSystem
+    virtual void OnFixedStep(double dt) override;
+
+    void Detect();
+    void GatherProxies();
+    void BuildBroadPhase();
+    void DetectPairs(size_t begin, size_t end, PairBuffer & out) const;
+    void DetectBruteForce(size_t begin, size_t end, PairBuffer & out) const;
+    void BuildUniformGrid();
+    void DetectUniformGrid(size_t begin, size_t end, PairBuffer & out) const;
+    void TestCellPairs(size_t idx, int32_t cx, int32_t cy, PairBuffer & out) const;
+    void DetectSweepAndPrune(size_t begin, size_t end, PairBuffer & out) const;
+    void SyncSapIntervals();
+    void TestPair(size_t idxA, size_t idxB, PairBuffer & out) const;
+    void UpdatePairCache();
+    void EndPair(const CachedPair & pair);
+    void ReportContacts();
+
+    const std::shared_ptr<astu::Entity> & GetEntity(const Contact & contact, uint32_t handle) const {
+        return contact.state == ContactState::END ? endedEntities[handle] : *proxies[handle].entity;
+    }
+};
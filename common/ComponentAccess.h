@@ -0,0 +1,74 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Describes which component data a system reads and writes.
+ * 
+ * Systems whose accesses do not conflict may run at the same time. Data is
+ * identified per field rather than per component type, e.g., the position
+ * and orientation of a Pose2D can be written concurrently.
+ */
+class ComponentAccess {
+public:
+
+    /** Flags identifying component data. */
+    enum Data : uint32_t {
+        /** The position of Pose2D. */
+        POSITION = 1 << 0,
+
+        /** The orientation of Pose2D. */
+        ORIENTATION = 1 << 1,
+
+        /** The velocity of LinearMovement. */
+        VELOCITY = 1 << 2,
+
+        /** The rotation speed of AutoRotate. */
+        ROTATION_SPEED = 1 << 3,
+
+        /** The data of CircleCollider. */
+        COLLIDER = 1 << 4,
+
+        /** The data of Polyline. */
+        POLYLINE = 1 << 5,
+    };
+
+    /** The component data being read. */
+    uint32_t reads;
+
+    /** The component data being written. */
+    uint32_t writes;
+
+    /**
+     * Constructor.
+     * 
+     * @param r the component data being read
+     * @param w the component data being written
+     */
+    ComponentAccess(uint32_t r = 0, uint32_t w = 0)
+        : reads(r), writes(w)
+    {
+        // Intentionally left empty.
+    }
+
+    /**
+     * Tests whether this access conflicts with another one.
+     * 
+     * @param o the other access
+     * @return `true` if both accesses must not happen at the same time
+     */
+    bool ConflictsWith(const ComponentAccess & o) const {
+        return (writes & (o.reads | o.writes)) || (o.writes & reads);
+    }
+};
@@ -0,0 +1,65 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include "EntityDestroyQueue.h"
+
+using namespace astu;
+
+EntityDestroyQueue::EntityDestroyQueue(int priority)
+    : UpdatableBaseService("Entity Destroy Queue", priority)
+{
+    // Intentionally left empty.
+}
+
+bool EntityDestroyQueue::Destroy(const std::shared_ptr<Entity> & entity)
+{
+    if (!dead.insert(entity.get()).second) {
+        return false;
+    }
+    pending.push_back(entity);
+    return true;
+}
+
+void EntityDestroyQueue::Flush()
+{
+    if (pending.empty()) {
+        return;
+    }
+
+    auto & es = GetSM().GetService<EntityService>();
+    for (const auto & entity : pending) {
+        es.RemoveEntity(entity);
+    }
+    pending.clear();
+    dead.clear();
+}
+
+void EntityDestroyQueue::OnStartup()
+{
+    // Intentionally left empty.
+}
+
+void EntityDestroyQueue::OnShutdown()
+{
+    Flush();
+}
+
+void EntityDestroyQueue::OnUpdate()
+{
+    if (!IsStepped()) {
+        Flush();
+    }
+}
+
+void EntityDestroyQueue::OnFixedStep(double dt)
+{
+    Flush();
+}
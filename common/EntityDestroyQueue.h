@@ -0,0 +1,80 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <unordered_set>
+#include <UpdateService.h>
+#include <EntityService.h>
+#include "FixedStepSystem.h"
+
+/**
+ * Collects entities to be destroyed and removes them at the end of the frame.
+ * 
+ * An entity is marked dead as soon as it is queued, so later requests, 
+ * e.g., further collision events of the same frame, can skip it. Queuing
+ * an entity several times removes it only once. This service should be
+ * updated after all services which destroy entities. If the simulation is
+ * advanced by a FixedStepService, the queue should be stepped as well, so
+ * entities are removed at the end of each step.
+ */
+class EntityDestroyQueue : public astu::UpdatableBaseService, public FixedStepSystem {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param priority  the update priority of this service
+     */
+    EntityDestroyQueue(int priority = 0);
+
+    /**
+     * Queues an entity for removal.
+     * 
+     * @param entity    the entity to destroy
+     * @return `false` if the entity has already been queued
+     */
+    bool Destroy(const std::shared_ptr<astu::Entity> & entity);
+
+    /**
+     * Tests whether an entity has been queued for removal.
+     * 
+     * @param entity    the entity to test
+     * @return `true` if the entity is dead
+     */
+    bool IsDead(const std::shared_ptr<astu::Entity> & entity) const {
+        return dead.find(entity.get()) != dead.end();
+    }
+
+    /**
+     * Removes all queued entities from the entity service.
+     */
+    void Flush();
+
+protected:
+
+    // Inherited via UpdatableBaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+    virtual void OnUpdate() override;
+
+    // Inherited via FixedStepSystem
+    virtual void OnFixedStep(double dt) override;
+
+private:
+    /** The entities to remove, in order of their first request. */
+    std::vector<std::shared_ptr<astu::Entity>> pending;
+
+    /** The queued entities. */
+    std::unordered_set<const astu::Entity*> dead;
+};
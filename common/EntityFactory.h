@@ -0,0 +1,49 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <EntityService.h>
+#include "PoolAllocator.h"
+
+/**
+ * Creates entities and components from memory pools.
+ * 
+ * Each object shares one pooled block with its reference count. Once an
+ * entity has been removed and its last reference is gone, the blocks of
+ * the entity and its components are recycled by the next spawn.
+ */
+class EntityFactory {
+public:
+
+    /**
+     * Creates a new entity without components.
+     * 
+     * @return the new entity
+     */
+    static std::shared_ptr<astu::Entity> CreateEntity() {
+        return std::allocate_shared<astu::Entity>(PoolAllocator<astu::Entity>());
+    }
+
+    /**
+     * Creates a new component.
+     * 
+     * @tparam T    the type of the component
+     * @param args  the arguments passed to the constructor of the component
+     * @return the new component
+     */
+    template <typename T, typename... Args>
+    static std::shared_ptr<T> CreateComponent(Args&&... args) {
+        return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+    }
+};
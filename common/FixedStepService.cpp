@@ -0,0 +1,119 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <stdexcept>
+#include <cmath>
+#include "Pose2D.h"
+#include "FrameProfiler.h"
+#include "FixedStepService.h"
+
+using namespace astu;
+
+FixedStepService::FixedStepService(double _stepTime, int _maxSteps, int priority)
+    : UpdatableBaseService("Fixed Step Service", priority)
+    , stepTime(_stepTime)
+    , maxSteps(_maxSteps)
+    , accumulator(0)
+    , alpha(0)
+    , numSteps(0)
+{
+    if (stepTime <= 0) {
+        throw std::domain_error("Step time must be greater zero");
+    }
+    if (maxSteps < 1) {
+        throw std::domain_error("Maximum number of steps per frame must be at least one");
+    }
+}
+
+void FixedStepService::AddSystem(std::shared_ptr<FixedStepSystem> system)
+{
+    systems.push_back(system);
+}
+
+void FixedStepService::OnStartup()
+{
+    timeService = GetSM().FindService<ITimeService>();
+    if (!timeService) {
+        throw std::logic_error("Time service required for " + GetName());
+    }
+
+    auto es = GetSM().FindService<EntityService>();
+    if (es) {
+        entityView = es->GetEntityView(EntityFamily::Create<Pose2D>());
+    }
+    store = GetSM().FindService<SoaComponentStore>();
+
+    for (auto & system : systems) {
+        system->stepped = true;
+    }
+    accumulator = 0;
+    alpha = 0;
+    numSteps = 0;
+}
+
+void FixedStepService::OnShutdown()
+{
+    for (auto & system : systems) {
+        system->stepped = false;
+    }
+    timeService = nullptr;
+    entityView = nullptr;
+    store = nullptr;
+}
+
+void FixedStepService::OnUpdate()
+{
+    if (!IsPipelined()) {
+        Advance();
+    }
+}
+
+void FixedStepService::OnPipelinedUpdate()
+{
+    Advance();
+}
+
+void FixedStepService::Advance()
+{
+    BAGAGA_PROFILE_SCOPE(GetName().c_str());
+    accumulator += timeService->GetElapsedTime();
+
+    int n = 0;
+    while (accumulator >= stepTime && n < maxSteps) {
+        Step();
+        accumulator -= stepTime;
+        ++n;
+    }
+
+    // Drop what could not be caught up, keeping the phase of the steps.
+    if (accumulator >= stepTime) {
+        accumulator = std::fmod(accumulator, stepTime);
+    }
+    alpha = accumulator / stepTime;
+}
+
+void FixedStepService::Step()
+{
+    BAGAGA_PROFILE_SCOPE("Fixed Step");
+    if (entityView) {
+        for (size_t i = 0; i < entityView->size(); ++i) {
+            (*entityView)[i]->GetComponent<Pose2D>().SavePrevious();
+        }
+    }
+    if (store) {
+        store->SavePreviousPoses();
+    }
+
+    for (auto & system : systems) {
+        system->OnFixedStep(stepTime);
+    }
+    ++numSteps;
+}
@@ -0,0 +1,140 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <UpdateService.h>
+#include <EntityService.h>
+#include <ITimeService.h>
+#include "FixedStepSystem.h"
+#include "PipelinedSystem.h"
+#include "SoaComponentStore.h"
+
+/**
+ * Advances a group of simulation systems with a constant time step.
+ * 
+ * The real time elapsed per frame, as reported by the time service, is
+ * accumulated and consumed in steps of constant length. Depending on the
+ * frame rate, the systems are stepped several times or not at all during
+ * one frame. Under load at most a maximum number of steps is executed per
+ * frame, the remaining time is dropped instead of being caught up later.
+ * 
+ * Before each step the poses of all entities are saved as previous poses.
+ * The fraction of a step left in the accumulator is used by rendering to
+ * interpolate between the previous and the current poses.
+ * 
+ * Like with parallel system groups, the systems must also be added as
+ * services, but are no longer updated on their own while being part of
+ * a started fixed step service. Systems are stepped in the order they
+ * have been added. This service should be updated before any rendering.
+ * 
+ * The service can be run on the worker thread of a FramePipeline.
+ */
+class FixedStepService : public astu::UpdatableBaseService, public PipelinedSystem {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param stepTime  the length of a simulation step in seconds
+     * @param maxSteps  the maximum number of steps per frame
+     * @param priority  the update priority of this service
+     */
+    FixedStepService(double stepTime = 1.0 / 60.0, int maxSteps = 5, int priority = 0);
+
+    /**
+     * Adds a system to this service. Systems must be added before the 
+     * service is started.
+     * 
+     * @param system    the system to add
+     */
+    void AddSystem(std::shared_ptr<FixedStepSystem> system);
+
+    /**
+     * Returns the length of a simulation step.
+     * 
+     * @return the step time in seconds
+     */
+    double GetStepTime() const {
+        return stepTime;
+    }
+
+    /**
+     * Returns the position of the current frame between the previous and
+     * the last simulation step.
+     * 
+     * @return the interpolation factor within [0, 1)
+     */
+    double GetInterpolationFactor() const {
+        return alpha;
+    }
+
+    /**
+     * Returns the number of steps executed since this service has been
+     * started.
+     * 
+     * @return the number of steps
+     */
+    uint64_t GetNumSteps() const {
+        return numSteps;
+    }
+
+protected:
+
+    // Inherited via UpdatableBaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+    virtual void OnUpdate() override;
+
+    // Inherited via PipelinedSystem
+    virtual void OnPipelinedUpdate() override;
+
+private:
+    /** The systems stepped by this service. */
+    std::vector<std::shared_ptr<FixedStepSystem>> systems;
+
+    /** The length of a simulation step in seconds. */
+    double stepTime;
+
+    /** The maximum number of steps per frame. */
+    int maxSteps;
+
+    /** The elapsed time not yet consumed by steps. */
+    double accumulator;
+
+    /** The interpolation factor of the current frame. */
+    double alpha;
+
+    /** The number of steps executed since startup. */
+    uint64_t numSteps;
+
+    /** Used for fast access to time service. */
+    std::shared_ptr<astu::ITimeService> timeService;
+
+    /** The entities whose poses are saved before each step, if any. */
+    std::shared_ptr<astu::EntityView> entityView;
+
+    /** The optional dense component store, whose poses are saved as well. */
+    std::shared_ptr<SoaComponentStore> store;
+
+    /**
+     * Consumes the elapsed time in steps.
+     */
+    void Advance();
+
+    /**
+     * Executes one simulation step.
+     */
+    void Step();
+};
@@ -0,0 +1,63 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+/**
+ * Base class for systems which advance the simulation and can be stepped
+ * by a FixedStepService with a constant time step.
+ * 
+ * Systems stepped by a started FixedStepService must not advance the
+ * simulation in their regular update. Derived systems are expected to
+ * check IsStepped() in their update and to do the work of one simulation
+ * step in OnFixedStep().
+ */
+class FixedStepSystem {
+public:
+
+    /**
+     * Virtual destructor.
+     */
+    virtual ~FixedStepSystem() {}
+
+    /**
+     * Tests whether this system is stepped by a fixed step service.
+     * 
+     * @return `true` if this system is stepped
+     */
+    bool IsStepped() const {
+        return stepped;
+    }
+
+protected:
+
+    /**
+     * Constructor.
+     */
+    FixedStepSystem()
+        : stepped(false)
+    {
+        // Intentionally left empty.
+    }
+
+    /**
+     * Advances the simulation by one step.
+     * 
+     * @param dt    the length of the step in seconds
+     */
+    virtual void OnFixedStep(double dt) = 0;
+
+private:
+    /** Whether this system is stepped by a fixed step service. */
+    bool stepped;
+
+    friend class FixedStepService;
+};
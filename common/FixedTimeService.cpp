@@ -0,0 +1,42 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <stdexcept>
+#include "FixedTimeService.h"
+
+FixedTimeService::FixedTimeService(double dt)
+    : BaseService("Fixed Time Service")
+{
+    SetElapsedTime(dt);
+}
+
+void FixedTimeService::SetElapsedTime(double dt)
+{
+    if (dt <= 0) {
+        throw std::domain_error("Elapsed time per frame must be greater zero");
+    }
+    deltaTime = dt;
+}
+
+double FixedTimeService::GetElapsedTime() const
+{
+    return deltaTime;
+}
+
+void FixedTimeService::OnStartup()
+{
+    // Intentionally left empty.
+}
+
+void FixedTimeService::OnShutdown()
+{
+    // Intentionally left empty.
+}
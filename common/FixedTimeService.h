@@ -0,0 +1,53 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <Service.h>
+#include <ITimeService.h>
+
+/**
+ * A time service which reports the same elapsed time for every frame.
+ * 
+ * This service replaces the SDL time service when the simulation runs
+ * without a window, which makes runs reproducible and independent of the
+ * speed of the machine.
+ */
+class FixedTimeService : public astu::BaseService, public astu::ITimeService {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param dt    the elapsed time per frame in seconds
+     */
+    FixedTimeService(double dt = 1.0 / 60.0);
+
+    /**
+     * Sets the elapsed time per frame.
+     * 
+     * @param dt    the elapsed time per frame in seconds
+     */
+    void SetElapsedTime(double dt);
+
+    // Inherited via ITimeService
+    virtual double GetElapsedTime() const override;
+
+protected:
+
+    // Inherited via BaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+
+private:
+    /** The elapsed time per frame in seconds. */
+    double deltaTime;
+};
@@ -0,0 +1,124 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <stdexcept>
+#include "FrameProfiler.h"
+#include "FramePipeline.h"
+
+using namespace astu;
+
+FramePipeline::FramePipeline(int renderPriority)
+    : BaseSdlRenderLayer(renderPriority, "Frame Pipeline")
+    , busy(false)
+    , running(false)
+{
+    // Intentionally left empty.
+}
+
+void FramePipeline::AddSystem(std::shared_ptr<PipelinedSystem> system)
+{
+    systems.push_back(system);
+}
+
+void FramePipeline::OnStartup()
+{
+    lineRenderer = GetSM().FindService<SdlLineRenderer>();
+    if (!lineRenderer) {
+        throw std::logic_error("SDL line renderer required for " + GetName());
+    }
+
+    // The worker submits the frames once they have been recorded.
+    lineRenderer->SetAutoSubmit(false);
+    for (auto & system : systems) {
+        system->pipelined = true;
+    }
+
+    busy = false;
+    running = true;
+    worker = std::thread(&FramePipeline::WorkerLoop, this);
+}
+
+void FramePipeline::OnShutdown()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        signal.wait(lock, [this] { return !busy; });
+        running = false;
+        exception = nullptr;
+    }
+    signal.notify_all();
+    worker.join();
+
+    for (auto & system : systems) {
+        system->pipelined = false;
+    }
+    lineRenderer->SetAutoSubmit(true);
+    lineRenderer = nullptr;
+}
+
+void FramePipeline::Sync()
+{
+    std::exception_ptr e;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        signal.wait(lock, [this] { return !busy; });
+        std::swap(e, exception);
+    }
+
+    if (e) {
+        std::rethrow_exception(e);
+    }
+}
+
+void FramePipeline::OnRender(SDL_Renderer* renderer)
+{
+    // The previous frame must have been submitted before it is replayed.
+    Sync();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        busy = true;
+    }
+    signal.notify_all();
+}
+
+void FramePipeline::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        signal.wait(lock, [this] { return busy || !running; });
+        if (!running) {
+            return;
+        }
+
+        lock.unlock();
+        try {
+            RunFrame();
+        } catch (...) {
+            lock.lock();
+            exception = std::current_exception();
+            lock.unlock();
+        }
+
+        lock.lock();
+        busy = false;
+        signal.notify_all();
+    }
+}
+
+void FramePipeline::RunFrame()
+{
+    BAGAGA_PROFILE_SCOPE(GetName().c_str());
+    for (auto & system : systems) {
+        system->OnPipelinedUpdate();
+    }
+    lineRenderer->SubmitFrame();
+}
@@ -0,0 +1,105 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <SdlRenderService.h>
+#include "PipelinedSystem.h"
+#include "SdlLineRenderer.h"
+
+/**
+ * Runs a group of systems on a worker thread, which records frame N+1
+ * while the SDL render service replays and presents frame N.
+ * 
+ * This service is a SDL render layer. When rendered, it waits for the
+ * worker to finish the previous frame and starts it on the next frame.
+ * The worker runs the systems in the order they have been added and then
+ * submits the recorded frame to the SdlLineRenderer. While this service
+ * is started, the line renderer no longer submits frames on its own.
+ * 
+ * Like with fixed step services, the systems must also be added as
+ * services, but are no longer updated on their own while being part of
+ * a started pipeline. The game loop must call Sync after updating all
+ * services, before events are handled and other services touch the
+ * entities or record render calls again.
+ */
+class FramePipeline : public astu::BaseSdlRenderLayer {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param renderPriority    the priority of this render layer
+     */
+    FramePipeline(int renderPriority = 0);
+
+    /**
+     * Virtual destructor.
+     */
+    virtual ~FramePipeline() {}
+
+    /**
+     * Adds a system to this pipeline. Systems must be added before the 
+     * pipeline is started.
+     * 
+     * @param system    the system to add
+     */
+    void AddSystem(std::shared_ptr<PipelinedSystem> system);
+
+    /**
+     * Waits until the worker has finished the current frame. Exceptions
+     * thrown by the systems on the worker are rethrown here.
+     */
+    void Sync();
+
+    // Inherited via BaseSdlRenderLayer
+    virtual void OnRender(SDL_Renderer* renderer) override;
+
+protected:
+
+    // Inherited via BaseSdlRenderLayer
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+
+private:
+    /** The systems run by this pipeline. */
+    std::vector<std::shared_ptr<PipelinedSystem>> systems;
+
+    /** The line renderer the recorded frames are submitted to. */
+    std::shared_ptr<SdlLineRenderer> lineRenderer;
+
+    /** The worker thread. */
+    std::thread worker;
+
+    /** Guards the state shared with the worker. */
+    std::mutex mutex;
+
+    /** Used to wake up the worker and to wait for it. */
+    std::condition_variable signal;
+
+    /** Whether a frame has been started and is not yet finished. */
+    bool busy;
+
+    /** Whether the worker should keep running. */
+    bool running;
+
+    /** The first exception thrown on the worker during a frame. */
+    std::exception_ptr exception;
+
+    void WorkerLoop();
+    void RunFrame();
+};
@@ -0,0 +1,184 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <new>
+#include "FrameProfiler.h"
+
+#define MAX_SAMPLES_PER_FRAME 4096
+
+using namespace astu;
+
+std::atomic<FrameProfiler*> FrameProfiler::activeProfiler(nullptr);
+
+/** The number of threads which have recorded a sample. */
+static std::atomic<uint32_t> numThreads(0);
+
+/** The number of memory allocations of the current thread. */
+static thread_local size_t tlsAllocations = 0;
+
+#ifdef BAGAGA_PROFILE_ALLOCATIONS
+
+void* operator new(std::size_t size)
+{
+    ++tlsAllocations;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+#endif
+
+static int64_t GetTicks()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+FrameProfiler::FrameProfiler(const std::string & _traceFile, size_t numFrames, int priority)
+    : UpdatableBaseService("Frame Profiler", priority)
+    , traceFile(_traceFile)
+    , frames(numFrames < 2 ? 2 : numFrames)
+    , frameCounter(0)
+    , enabled(true)
+    , epoch(GetTicks())
+{
+    for (auto & frame : frames) {
+        frame.samples.resize(MAX_SAMPLES_PER_FRAME);
+    }
+}
+
+size_t FrameProfiler::GetThreadAllocations()
+{
+    return tlsAllocations;
+}
+
+uint32_t FrameProfiler::GetThreadIndex()
+{
+    static thread_local uint32_t threadIdx = numThreads.fetch_add(1);
+    return threadIdx;
+}
+
+int64_t FrameProfiler::GetTime() const
+{
+    return GetTicks() - epoch;
+}
+
+void FrameProfiler::Record(const ProfileSample & sample)
+{
+    Frame & frame = GetCurrentFrame();
+    size_t idx = frame.numSamples.fetch_add(1, std::memory_order_acq_rel);
+    if (idx < frame.samples.size()) {
+        frame.samples[idx] = sample;
+    }
+}
+
+size_t FrameProfiler::GetNumFrames() const
+{
+    return frameCounter < frames.size() ? frameCounter : frames.size() - 1;
+}
+
+const FrameProfiler::Frame & FrameProfiler::GetFrame(size_t age) const
+{
+    return frames[(frameCounter - 1 - age) % frames.size()];
+}
+
+void FrameProfiler::WriteChromeTrace(std::ostream & os) const
+{
+    // Timestamps are given in microseconds, keep nanosecond resolution
+    // instead of the default six significant digits.
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+
+    os << "{\"traceEvents\":[";
+
+    bool first = true;
+    for (size_t age = GetNumFrames(); age-- > 0; ) {
+        const Frame & frame = GetFrame(age);
+        os << (first ? "\n" : ",\n");
+        first = false;
+
+        os << "{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":0,\"tid\":0"
+            << ",\"ts\":" << frame.start / 1000.0 
+            << ",\"dur\":" << frame.duration / 1000.0 << "}";
+
+        for (size_t i = 0; i < frame.GetNumSamples(); ++i) {
+            const ProfileSample & s = frame.samples[i];
+            os << ",\n{\"name\":\"" << s.name << "\",\"ph\":\"X\",\"pid\":0"
+                << ",\"tid\":" << s.thread
+                << ",\"ts\":" << s.start / 1000.0
+                << ",\"dur\":" << s.duration / 1000.0
+                << ",\"args\":{\"count\":" << s.count 
+                << ",\"allocations\":" << s.allocations << "}}";
+        }
+    }
+
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void FrameProfiler::OnStartup()
+{
+    frameCounter = 0;
+    BeginFrame();
+    activeProfiler.store(this);
+}
+
+void FrameProfiler::OnShutdown()
+{
+    activeProfiler.store(nullptr);
+
+    if (traceFile.empty()) {
+        return;
+    }
+
+    std::ofstream out(traceFile);
+    if (!out) {
+        std::cerr << "unable to write profiler trace to " << traceFile << std::endl;
+        return;
+    }
+    WriteChromeTrace(out);
+}
+
+void FrameProfiler::OnUpdate()
+{
+    // Jobs of the previous frame have completed, no samples are recorded now.
+    Frame & frame = GetCurrentFrame();
+    frame.duration = GetTime() - frame.start;
+    ++frameCounter;
+    BeginFrame();
+}
+
+void FrameProfiler::BeginFrame()
+{
+    Frame & frame = GetCurrentFrame();
+    frame.start = GetTime();
+    frame.duration = 0;
+    frame.numSamples.store(0, std::memory_order_release);
+}
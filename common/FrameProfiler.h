@@ -0,0 +1,258 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+#include <UpdateService.h>
+
+/**
+ * Profiles the enclosing scope under the specified name.
+ * 
+ * Expands to nothing unless BAGAGA_PROFILER is defined.
+ */
+#ifdef BAGAGA_PROFILER
+#define BAGAGA_PROFILE_SCOPE(name) ProfileScope BAGAGA_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define BAGAGA_PROFILE_SCOPE_COUNT(name, count) ProfileScope BAGAGA_PROFILE_CONCAT(profileScope, __LINE__)(name, count)
+#else
+#define BAGAGA_PROFILE_SCOPE(name) ((void) 0)
+#define BAGAGA_PROFILE_SCOPE_COUNT(name, count) ((void) 0)
+#endif
+
+#define BAGAGA_PROFILE_CONCAT_INNER(a, b) a ## b
+#define BAGAGA_PROFILE_CONCAT(a, b) BAGAGA_PROFILE_CONCAT_INNER(a, b)
+
+/**
+ * A single measurement of a profiled scope.
+ */
+struct ProfileSample {
+    /** The name of the scope, must outlive the profiler. */
+    const char* name;
+
+    /** The start time in nanoseconds since the profiler has been created. */
+    int64_t start;
+
+    /** The duration in nanoseconds. */
+    int64_t duration;
+
+    /** The number of processed items, e.g., entities. */
+    size_t count;
+
+    /** The number of memory allocations made by the scope. */
+    size_t allocations;
+
+    /** The index of the thread which executed the scope. */
+    uint32_t thread;
+};
+
+/**
+ * Records the profiled scopes of the most recent frames.
+ * 
+ * Each call of OnUpdate marks the boundary between two frames. The frames
+ * are kept in a ring buffer with a fixed number of samples per frame;
+ * recording a sample is lock-free and may happen on any thread. Samples
+ * exceeding the capacity of a frame are dropped.
+ * 
+ * Memory allocations are only counted if BAGAGA_PROFILE_ALLOCATIONS is
+ * defined, which replaces the global operator new.
+ */
+class FrameProfiler : public astu::UpdatableBaseService {
+public:
+
+    /** The samples of one frame. */
+    struct Frame {
+        /** The start time in nanoseconds since the profiler has been created. */
+        int64_t start = 0;
+
+        /** The duration in nanoseconds, zero while the frame is recorded. */
+        int64_t duration = 0;
+
+        /** The recorded samples, sized to the capacity of the frame. */
+        std::vector<ProfileSample> samples;
+
+        /** The number of recorded samples, including dropped ones. */
+        std::atomic<size_t> numSamples{0};
+
+        /**
+         * Returns the number of valid samples.
+         * 
+         * @return the number of valid samples
+         */
+        size_t GetNumSamples() const {
+            size_t n = numSamples.load(std::memory_order_acquire);
+            return n < samples.size() ? n : samples.size();
+        }
+    };
+
+    /**
+     * Constructor.
+     * 
+     * @param traceFile     the Chrome trace file written on shutdown, empty for none
+     * @param numFrames     the number of frames kept in the ring buffer
+     * @param priority      the update priority, determines the frame boundary
+     */
+    FrameProfiler(const std::string & traceFile = "", size_t numFrames = 300, int priority = 0);
+
+    /**
+     * Returns the active and enabled profiler.
+     * 
+     * @return the profiler or `nullptr` if none is active
+     */
+    static FrameProfiler* GetActive() {
+        FrameProfiler* profiler = activeProfiler.load(std::memory_order_relaxed);
+        return profiler && profiler->enabled.load(std::memory_order_relaxed) ? profiler : nullptr;
+    }
+
+    /**
+     * Returns the number of memory allocations of the calling thread.
+     * 
+     * @return the number of allocations, zero if allocations are not counted
+     */
+    static size_t GetThreadAllocations();
+
+    /**
+     * Returns the index of the calling thread used in samples.
+     * 
+     * @return the thread index
+     */
+    static uint32_t GetThreadIndex();
+
+    /**
+     * Enables or disables recording.
+     * 
+     * @param b `true` to enable recording
+     */
+    void SetEnabled(bool b) {
+        enabled.store(b, std::memory_order_relaxed);
+    }
+
+    /**
+     * Returns the current time.
+     * 
+     * @return the time in nanoseconds since the profiler has been created
+     */
+    int64_t GetTime() const;
+
+    /**
+     * Adds a sample to the current frame.
+     * 
+     * @param sample    the sample to add
+     */
+    void Record(const ProfileSample & sample);
+
+    /**
+     * Returns the number of completed frames in the ring buffer.
+     * 
+     * @return the number of completed frames
+     */
+    size_t GetNumFrames() const;
+
+    /**
+     * Returns a completed frame.
+     * 
+     * @param age   the age of the frame, zero for the most recently completed one
+     * @return the frame
+     */
+    const Frame & GetFrame(size_t age) const;
+
+    /**
+     * Writes the completed frames in the Chrome trace event format.
+     * 
+     * @param os    the output stream
+     */
+    void WriteChromeTrace(std::ostream & os) const;
+
+protected:
+
+    // Inherited via UpdatableBaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+    virtual void OnUpdate() override;
+
+private:
+    /** The active profiler. */
+    static std::atomic<FrameProfiler*> activeProfiler;
+
+    /** The Chrome trace file written on shutdown. */
+    std::string traceFile;
+
+    /** The ring buffer of frames. */
+    std::vector<Frame> frames;
+
+    /** The number of frames started so far. */
+    size_t frameCounter;
+
+    /** Whether recording is enabled. */
+    std::atomic<bool> enabled;
+
+    /** The creation time, in ticks of the steady clock. */
+    int64_t epoch;
+
+    Frame & GetCurrentFrame() {
+        return frames[frameCounter % frames.size()];
+    }
+
+    void BeginFrame();
+};
+
+/**
+ * Measures the lifetime of a scope and records it with the active profiler.
+ * 
+ * Use the BAGAGA_PROFILE_SCOPE macros instead of this class, so the
+ * measurement can be compiled out.
+ */
+class ProfileScope {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param name  the name of the scope, must outlive the profiler
+     * @param count the number of items processed by the scope
+     */
+    ProfileScope(const char* name, size_t count = 0)
+        : profiler(FrameProfiler::GetActive())
+    {
+        if (profiler) {
+            sample.name = name;
+            sample.count = count;
+            sample.allocations = FrameProfiler::GetThreadAllocations();
+            sample.start = profiler->GetTime();
+        }
+    }
+
+    /**
+     * Destructor, records the sample.
+     */
+    ~ProfileScope() {
+        if (profiler) {
+            sample.duration = profiler->GetTime() - sample.start;
+            sample.allocations = FrameProfiler::GetThreadAllocations() - sample.allocations;
+            sample.thread = FrameProfiler::GetThreadIndex();
+            profiler->Record(sample);
+        }
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope & operator=(const ProfileScope &) = delete;
+
+private:
+    /** The profiler which records the sample. */
+    FrameProfiler* profiler;
+
+    /** The sample of this scope. */
+    ProfileSample sample;
+};
@@ -0,0 +1,58 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <stdexcept>
+#include "HeadlessWindowManager.h"
+
+HeadlessWindowManager::HeadlessWindowManager(int width, int height)
+    : BaseService("Headless Window Manager")
+{
+    SetSize(width, height);
+}
+
+void HeadlessWindowManager::SetSize(int w, int h)
+{
+    if (w <= 0 || h <= 0) {
+        throw std::domain_error("Window size must be greater zero");
+    }
+    width = w;
+    height = h;
+}
+
+int HeadlessWindowManager::GetWidth() const
+{
+    return width;
+}
+
+int HeadlessWindowManager::GetHeight() const
+{
+    return height;
+}
+
+void HeadlessWindowManager::SetTitle(const std::string & t)
+{
+    title = t;
+}
+
+const std::string & HeadlessWindowManager::GetTitle() const
+{
+    return title;
+}
+
+void HeadlessWindowManager::OnStartup()
+{
+    // Intentionally left empty.
+}
+
+void HeadlessWindowManager::OnShutdown()
+{
+    // Intentionally left empty.
+}
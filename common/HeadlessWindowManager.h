@@ -0,0 +1,57 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <string>
+#include <Service.h>
+#include <IWindowManager.h>
+
+/**
+ * A window manager without a window.
+ * 
+ * This service only stores the window size and title, so services which
+ * require an IWindowManager can run without a video device.
+ */
+class HeadlessWindowManager : public astu::BaseService, public astu::IWindowManager {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param width     the width of the virtual window
+     * @param height    the height of the virtual window
+     */
+    HeadlessWindowManager(int width = 640, int height = 480);
+
+    // Inherited via IWindowManager
+    virtual void SetSize(int width, int height) override;
+    virtual int GetWidth() const override;
+    virtual int GetHeight() const override;
+    virtual void SetTitle(const std::string & title) override;
+    virtual const std::string & GetTitle() const override;
+
+protected:
+
+    // Inherited via BaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+
+private:
+    /** The width of the virtual window. */
+    int width;
+
+    /** The height of the virtual window. */
+    int height;
+
+    /** The window title. */
+    std::string title;
+};
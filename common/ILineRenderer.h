@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include "Vector2.h"
 #include "Color.h"
 
@@ -24,7 +25,7 @@ public:
     /**
      * Virtual Destructor.
      */
-    ~ILineRenderer() {}
+    virtual ~ILineRenderer() {}
 
     /**
      * Draws a line between two points.
@@ -46,6 +47,40 @@ public:
      */
     virtual void DrawLine(double x1, double y1, double x2, double X2) = 0;
 
+    /**
+     * Draws a connected sequence of lines through a number of points.
+     * 
+     * The default implementation draws the lines one by one, renderers
+     * should override this method to submit the whole strip at once.
+     * 
+     * @param points    the points of the line strip
+     * @param n         the number of points
+     * @param closed    whether to connect the last point with the first one
+     */
+    virtual void DrawLineStrip(const astu::Vector2<double>* points, size_t n, bool closed = false) {
+        for (size_t i = 1; i < n; ++i) {
+            DrawLine(points[i - 1], points[i]);
+        }
+        if (closed && n > 2) {
+            DrawLine(points[n - 1], points[0]);
+        }
+    }
+
+    /**
+     * Draws independent lines, each given by two consecutive points.
+     * 
+     * The default implementation draws the lines one by one, renderers
+     * should override this method to submit all lines at once.
+     * 
+     * @param points    the end points of the lines
+     * @param n         the number of points, twice the number of lines
+     */
+    virtual void DrawLines(const astu::Vector2<double>* points, size_t n) {
+        for (size_t i = 1; i < n; i += 2) {
+            DrawLine(points[i - 1], points[i]);
+        }
+    }
+
     /**
      * Sets the current drawing color used for all subsequent drawing calles.
      * 
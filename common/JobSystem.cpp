@@ -0,0 +1,201 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <cassert>
+#include <algorithm>
+#include "JobSystem.h"
+
+/** The job system the current thread is a worker of. */
+static thread_local const JobSystem* tlsJobSystem = nullptr;
+
+/** The queue of the current worker thread. */
+static thread_local size_t tlsQueueIdx = 0;
+
+JobSystem::JobSystem(unsigned int n)
+    : BaseService("Job System")
+    , numWorkers(n)
+    , numQueued(0)
+    , running(false)
+{
+    if (numWorkers == 0) {
+        unsigned int hw = std::thread::hardware_concurrency();
+        numWorkers = hw > 1 ? hw - 1 : 1;
+    }
+}
+
+void JobSystem::OnStartup()
+{
+    for (size_t i = 0; i <= numWorkers; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+
+    running = true;
+    for (size_t i = 1; i <= numWorkers; ++i) {
+        workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+void JobSystem::OnShutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running = false;
+    }
+    wakeUp.notify_all();
+
+    for (auto & worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    queues.clear();
+    numQueued = 0;
+}
+
+void JobSystem::Submit(Job job, JobCounter & counter)
+{
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+    Push(Entry{std::move(job), &counter});
+    WakeWorkers();
+}
+
+void JobSystem::Wait(JobCounter & counter)
+{
+    const size_t queueIdx = GetQueueIndex();
+    while (!counter.IsDone()) {
+        if (!RunPendingJob(queueIdx)) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Rethrow on the waiting thread, the counter can be reused afterwards.
+    std::exception_ptr e;
+    {
+        std::lock_guard<std::mutex> lock(counter.mutex);
+        std::swap(e, counter.exception);
+    }
+    if (e) {
+        std::rethrow_exception(e);
+    }
+}
+
+void JobSystem::ParallelFor(size_t n, size_t grain, const std::function<void(size_t, size_t)> & fn)
+{
+    assert(grain > 0);
+    if (n <= grain || queues.empty()) {
+        if (n > 0) {
+            fn(0, n);
+        }
+        return;
+    }
+
+    // Queue all but the first chunk, which is processed by the calling thread.
+    JobCounter counter;
+    for (size_t begin = grain; begin < n; begin += grain) {
+        const size_t end = std::min(n, begin + grain);
+        counter.pending.fetch_add(1, std::memory_order_relaxed);
+        Push(Entry{[&fn, begin, end]() { fn(begin, end); }, &counter});
+    }
+    WakeWorkers();
+
+    // The queued chunks refer to fn and counter, wait for them even if
+    // the first chunk throws.
+    try {
+        fn(0, grain);
+    } catch (...) {
+        counter.SetException(std::current_exception());
+    }
+    Wait(counter);
+}
+
+void JobSystem::Push(Entry entry)
+{
+    auto & queue = *queues[GetQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.entries.push_back(std::move(entry));
+    }
+    numQueued.fetch_add(1, std::memory_order_release);
+}
+
+void JobSystem::WakeWorkers()
+{
+    // Acquire the mutex to make sure no worker is about to fall asleep.
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeUp.notify_all();
+}
+
+bool JobSystem::RunPendingJob(size_t queueIdx)
+{
+    Entry entry;
+    bool found = false;
+
+    // Take most recent job from own queue, steal oldest jobs from others.
+    for (size_t i = 0; i < queues.size() && !found; ++i) {
+        auto & queue = *queues[(queueIdx + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.entries.empty()) {
+            continue;
+        }
+
+        if (i == 0) {
+            entry = std::move(queue.entries.back());
+            queue.entries.pop_back();
+        } else {
+            entry = std::move(queue.entries.front());
+            queue.entries.pop_front();
+        }
+        found = true;
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    numQueued.fetch_sub(1, std::memory_order_relaxed);
+
+    // The job is counted as done in any case, otherwise waiting threads
+    // would spin forever. Its exception is rethrown by the waiting thread.
+    struct PendingGuard {
+        JobCounter & counter;
+        ~PendingGuard() { counter.pending.fetch_sub(1, std::memory_order_release); }
+    } guard{*entry.counter};
+    try {
+        entry.job();
+    } catch (...) {
+        entry.counter->SetException(std::current_exception());
+    }
+
+    return true;
+}
+
+size_t JobSystem::GetQueueIndex() const
+{
+    return tlsJobSystem == this ? tlsQueueIdx : 0;
+}
+
+void JobSystem::WorkerLoop(size_t queueIdx)
+{
+    tlsJobSystem = this;
+    tlsQueueIdx = queueIdx;
+
+    while (running) {
+        if (RunPendingJob(queueIdx)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this]() { 
+            return !running || numQueued.load(std::memory_order_acquire) > 0; 
+        });
+    }
+}
@@ -0,0 +1,177 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <exception>
+#include <condition_variable>
+#include <Service.h>
+
+/**
+ * Counts the pending jobs of a group of jobs.
+ */
+class JobCounter {
+public:
+
+    /** Constructor. */
+    JobCounter() : pending(0) {}
+
+    /**
+     * Tests whether all jobs counted by this counter have been executed.
+     * 
+     * @return `true` if there are no pending jobs
+     */
+    bool IsDone() const {
+        return pending.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    /** The number of pending jobs. */
+    std::atomic<size_t> pending;
+
+    /** Guards the exception. */
+    std::mutex mutex;
+
+    /** The first exception thrown by one of the jobs, if any. */
+    std::exception_ptr exception;
+
+    /**
+     * Keeps the exception thrown by a job, unless another job has 
+     * already thrown one.
+     * 
+     * @param e the exception
+     */
+    void SetException(std::exception_ptr e) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!exception) {
+            exception = e;
+        }
+    }
+
+    friend class JobSystem;
+};
+
+/**
+ * Executes jobs on a pool of worker threads.
+ * 
+ * Each worker owns a queue it takes jobs from in LIFO order. Idle workers
+ * steal jobs from the other queues in FIFO order. Threads waiting for jobs
+ * to finish execute pending jobs instead of blocking, hence jobs may wait
+ * for other jobs.
+ */
+class JobSystem : public astu::BaseService {
+public:
+
+    /** The type of jobs executed by this system. */
+    using Job = std::function<void()>;
+
+    /**
+     * Constructor.
+     * 
+     * @param numWorkers    the number of worker threads, zero to use one
+     *                      thread less than the number of hardware threads
+     */
+    JobSystem(unsigned int numWorkers = 0);
+
+    /**
+     * Submits a job for execution.
+     * 
+     * @param job       the job to execute
+     * @param counter   the counter used to wait for the job
+     */
+    void Submit(Job job, JobCounter & counter);
+
+    /**
+     * Waits until all jobs of a counter have been executed.
+     * The calling thread executes pending jobs while waiting.
+     * 
+     * Exceptions thrown by jobs are passed on to the waiting thread. The
+     * other jobs of the counter are executed nevertheless.
+     * 
+     * @param counter   the counter of the jobs to wait for
+     * @throws the first exception thrown by one of the jobs
+     */
+    void Wait(JobCounter & counter);
+
+    /**
+     * Splits a range into chunks and processes the chunks in parallel.
+     * Returns after all chunks have been processed.
+     * 
+     * @param n     the size of the range
+     * @param grain the maximum number of elements per chunk
+     * @param fn    called with the begin and end index of each chunk
+     * @throws the first exception thrown by one of the chunks
+     */
+    void ParallelFor(size_t n, size_t grain, const std::function<void(size_t, size_t)> & fn);
+
+    /**
+     * Returns the number of worker threads.
+     * 
+     * @return the number of worker threads
+     */
+    unsigned int GetNumWorkers() const {
+        return numWorkers;
+    }
+
+protected:
+
+    // Inherited via BaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+
+private:
+
+    /** A submitted job and the counter tracking it. */
+    struct Entry {
+        Job job;
+        JobCounter* counter;
+    };
+
+    /** A job queue, owned by a worker or shared by all other threads. */
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Entry> entries;
+    };
+
+    /** The number of worker threads. */
+    unsigned int numWorkers;
+
+    /** The job queues, index zero is used by threads other than workers. */
+    std::vector<std::unique_ptr<Queue>> queues;
+
+    /** The worker threads. */
+    std::vector<std::thread> workers;
+
+    /** The number of queued jobs, over all queues. */
+    std::atomic<size_t> numQueued;
+
+    /** Whether the workers should keep running. */
+    std::atomic<bool> running;
+
+    /** Used to put idle workers to sleep. */
+    std::mutex sleepMutex;
+
+    /** Used to wake up idle workers. */
+    std::condition_variable wakeUp;
+
+    void Push(Entry entry);
+    void WakeWorkers();
+    bool RunPendingJob(size_t queueIdx);
+    size_t GetQueueIndex() const;
+    void WorkerLoop(size_t queueIdx);
+};
@@ -9,6 +9,8 @@
  * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
  */
 
+#pragma once
+
 #include <EntityService.h>
 #include <Vector2.h>
 
@@ -0,0 +1,155 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <cstring>
+#include "LinearMovementKernel.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BAGAGA_KERNEL_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BAGAGA_KERNEL_SSE2
+#endif
+
+void IntegrateAndReflectScalar(double* px, double* py, double* vx, double* vy,
+    const uint8_t* flags, uint8_t mask, size_t n, double dt, double width, double height)
+{
+    for (size_t i = 0; i < n; ++i) {
+        if (!(flags[i] & mask)) {
+            continue;
+        }
+
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+
+        KeepWithinBoundary(px[i], vx[i], width);
+        KeepWithinBoundary(py[i], vy[i], height);
+    }
+}
+
+#if defined(BAGAGA_KERNEL_AVX2)
+
+/** Branch-free version of KeepWithinBoundary for four active lanes. */
+static inline void KeepWithinBoundary(__m256d & p, __m256d & v, __m256d limit, __m256d active)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d sign = _mm256_set1_pd(-0.0);
+
+    __m256d below = _mm256_and_pd(_mm256_cmp_pd(p, zero, _CMP_LT_OQ), active);
+    p = _mm256_blendv_pd(p, zero, below);
+    v = _mm256_xor_pd(v, _mm256_and_pd(below, sign));
+
+    __m256d above = _mm256_and_pd(_mm256_cmp_pd(p, limit, _CMP_GE_OQ), active);
+    p = _mm256_blendv_pd(p, _mm256_sub_pd(limit, _mm256_set1_pd(1)), above);
+    v = _mm256_xor_pd(v, _mm256_and_pd(above, sign));
+}
+
+void IntegrateAndReflect(double* px, double* py, double* vx, double* vy,
+    const uint8_t* flags, uint8_t mask, size_t n, double dt, double width, double height)
+{
+    const __m256d vdt = _mm256_set1_pd(dt);
+    const __m256d vwidth = _mm256_set1_pd(width);
+    const __m256d vheight = _mm256_set1_pd(height);
+    const __m256i vmask = _mm256_set1_epi64x(mask);
+    const __m256i izero = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32_t f;
+        std::memcpy(&f, flags + i, sizeof(f));
+        __m256i f64 = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(f));
+        __m256d active = _mm256_castsi256_pd(
+            _mm256_cmpgt_epi64(_mm256_and_si256(f64, vmask), izero));
+
+        __m256d x = _mm256_loadu_pd(px + i);
+        __m256d y = _mm256_loadu_pd(py + i);
+        __m256d u = _mm256_loadu_pd(vx + i);
+        __m256d w = _mm256_loadu_pd(vy + i);
+
+        x = _mm256_blendv_pd(x, _mm256_add_pd(x, _mm256_mul_pd(u, vdt)), active);
+        y = _mm256_blendv_pd(y, _mm256_add_pd(y, _mm256_mul_pd(w, vdt)), active);
+        KeepWithinBoundary(x, u, vwidth, active);
+        KeepWithinBoundary(y, w, vheight, active);
+
+        _mm256_storeu_pd(px + i, x);
+        _mm256_storeu_pd(py + i, y);
+        _mm256_storeu_pd(vx + i, u);
+        _mm256_storeu_pd(vy + i, w);
+    }
+
+    IntegrateAndReflectScalar(px + i, py + i, vx + i, vy + i, flags + i, mask, n - i, dt, width, height);
+}
+
+#elif defined(BAGAGA_KERNEL_SSE2)
+
+/** Selects lanes of b where the mask is set and lanes of a otherwise. */
+static inline __m128d Select(__m128d a, __m128d b, __m128d mask)
+{
+    return _mm_or_pd(_mm_and_pd(mask, b), _mm_andnot_pd(mask, a));
+}
+
+/** Branch-free version of KeepWithinBoundary for two active lanes. */
+static inline void KeepWithinBoundary(__m128d & p, __m128d & v, __m128d limit, __m128d active)
+{
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d sign = _mm_set1_pd(-0.0);
+
+    __m128d below = _mm_and_pd(_mm_cmplt_pd(p, zero), active);
+    p = Select(p, zero, below);
+    v = _mm_xor_pd(v, _mm_and_pd(below, sign));
+
+    __m128d above = _mm_and_pd(_mm_cmpge_pd(p, limit), active);
+    p = Select(p, _mm_sub_pd(limit, _mm_set1_pd(1)), above);
+    v = _mm_xor_pd(v, _mm_and_pd(above, sign));
+}
+
+void IntegrateAndReflect(double* px, double* py, double* vx, double* vy,
+    const uint8_t* flags, uint8_t mask, size_t n, double dt, double width, double height)
+{
+    const __m128d vdt = _mm_set1_pd(dt);
+    const __m128d vwidth = _mm_set1_pd(width);
+    const __m128d vheight = _mm_set1_pd(height);
+
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d active = _mm_castsi128_pd(_mm_set_epi64x(
+            (flags[i + 1] & mask) ? -1 : 0, 
+            (flags[i] & mask) ? -1 : 0));
+
+        __m128d x = _mm_loadu_pd(px + i);
+        __m128d y = _mm_loadu_pd(py + i);
+        __m128d u = _mm_loadu_pd(vx + i);
+        __m128d w = _mm_loadu_pd(vy + i);
+
+        x = Select(x, _mm_add_pd(x, _mm_mul_pd(u, vdt)), active);
+        y = Select(y, _mm_add_pd(y, _mm_mul_pd(w, vdt)), active);
+        KeepWithinBoundary(x, u, vwidth, active);
+        KeepWithinBoundary(y, w, vheight, active);
+
+        _mm_storeu_pd(px + i, x);
+        _mm_storeu_pd(py + i, y);
+        _mm_storeu_pd(vx + i, u);
+        _mm_storeu_pd(vy + i, w);
+    }
+
+    IntegrateAndReflectScalar(px + i, py + i, vx + i, vy + i, flags + i, mask, n - i, dt, width, height);
+}
+
+#else
+
+void IntegrateAndReflect(double* px, double* py, double* vx, double* vy,
+    const uint8_t* flags, uint8_t mask, size_t n, double dt, double width, double height)
+{
+    IntegrateAndReflectScalar(px, py, vx, vy, flags, mask, n, dt, width, height);
+}
+
+#endif
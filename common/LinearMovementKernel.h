@@ -0,0 +1,66 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Integrates packed positions and reflects velocities at the boundaries.
+ * 
+ * For each element i with (flags[i] & mask) != 0 the position is advanced
+ * by the velocity and kept within [0, width) and [0, height) by reflecting
+ * the velocity, exactly like the scalar per-entity implementation. Other
+ * elements are left untouched.
+ * 
+ * Uses AVX2 or SSE2 if enabled at compile time, scalar code otherwise.
+ * 
+ * @param px        the x-coordinates of the positions
+ * @param py        the y-coordinates of the positions
+ * @param vx        the x-components of the velocities
+ * @param vy        the y-components of the velocities
+ * @param flags     the component flags of each element
+ * @param mask      the flag bits selecting the elements to process
+ * @param n         the number of elements
+ * @param dt        the elapsed time in seconds
+ * @param width     the upper boundary along the x-axis
+ * @param height    the upper boundary along the y-axis
+ */
+void IntegrateAndReflect(double* px, double* py, double* vx, double* vy,
+    const uint8_t* flags, uint8_t mask, size_t n, double dt, double width, double height);
+
+/**
+ * Scalar reference implementation of IntegrateAndReflect.
+ * 
+ * @see IntegrateAndReflect
+ */
+void IntegrateAndReflectScalar(double* px, double* py, double* vx, double* vy,
+    const uint8_t* flags, uint8_t mask, size_t n, double dt, double width, double height);
+
+/**
+ * Keeps a coordinate within [0, limit) by reflecting the velocity.
+ * 
+ * @param p     the coordinate
+ * @param v     the velocity along the coordinate axis
+ * @param limit the upper boundary
+ */
+inline void KeepWithinBoundary(double & p, double & v, double limit)
+{
+    if (p < 0) {
+        p = 0;
+        v = -v;
+    }
+    if (p >= limit) {
+        p = limit - 1;
+        v = -v;
+    }
+}
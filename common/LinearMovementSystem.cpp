@@ -0,0 +1,65 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <IWindowManager.h>
+#include "Pose2D.h"
+#include "LinearMovement.h"
+#include "LinearMovementKernel.h"
+#include "LinearMovementSystem.h"
+
+using namespace astu;
+
+const EntityFamily LinearMovementSystem::FAMILY = EntityFamily::Create<Pose2D, LinearMovement>();
+
+LinearMovementSystem::LinearMovementSystem(int priority)
+    : BatchEntitySystem(
+        FAMILY, 
+        ComponentAccess(
+            ComponentAccess::POSITION | ComponentAccess::VELOCITY, 
+            ComponentAccess::POSITION | ComponentAccess::VELOCITY), 
+        priority, 
+        "Linear Movement System")
+{
+    // Intentionally left empty.
+}
+
+void LinearMovementSystem::OnStartup()
+{
+    BatchEntitySystem::OnStartup();
+
+    auto & wm = GetSM().GetService<astu::IWindowManager>();
+    width = wm.GetWidth();
+    height = wm.GetHeight();
+}
+
+void LinearMovementSystem::ProcessEntities(const EntityView & view, size_t begin, size_t end, double dt)
+{
+    for (size_t i = begin; i < end; ++i) {
+        auto & e = *view[i];
+        auto & pose = e.GetComponent<Pose2D>();
+        auto & mov = e.GetComponent<LinearMovement>();
+
+        pose.pos += mov.vel * dt;
+
+        // Keep within boundaries.
+        KeepWithinBoundary(pose.pos.x, mov.vel.x, width);
+        KeepWithinBoundary(pose.pos.y, mov.vel.y, height);
+    }
+}
+
+void LinearMovementSystem::ProcessStore(SoaComponentStore & store, size_t begin, size_t end, double dt)
+{
+    IntegrateAndReflect(
+        store.posX.data() + begin, store.posY.data() + begin, 
+        store.velX.data() + begin, store.velY.data() + begin, 
+        store.flags.data() + begin, SoaComponentStore::LINEAR_MOVEMENT, 
+        end - begin, dt, width, height);
+}
@@ -11,10 +11,9 @@
 
 #pragma once
 
-#include <IteratingEntitySystem.h>
-#include "ILineRenderer.h"
+#include "BatchEntitySystem.h"
 
-class LinearMovementSystem : public astu::IteratingEntitySystem {
+class LinearMovementSystem : public BatchEntitySystem {
 public:
 
     /**
@@ -26,10 +25,10 @@ public:
 
 protected:
 
-    // Inherited via IteratingEntitySystem
+    // Inherited via BatchEntitySystem
     virtual void OnStartup() override;
-    virtual void OnShutdown() override;
-    virtual void ProcessEntity(astu::Entity & e) override;
+    virtual void ProcessEntities(const astu::EntityView & view, size_t begin, size_t end, double dt) override;
+    virtual void ProcessStore(SoaComponentStore & store, size_t begin, size_t end, double dt) override;
 
 private:
     /** A constant describing the family of entities this system processes. */
@@ -40,4 +39,4 @@ private:
 
     /** The height of the output window. */
     double height;
-};
\ No newline at end of file
+};
@@ -0,0 +1,118 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <algorithm>
+#include <cassert>
+#include "MemoryPool.h"
+
+MemoryPool::MemoryPool(size_t size, size_t n)
+    : blockSize(std::max(size, sizeof(FreeBlock)))
+    , blocksPerChunk(std::max<size_t>(n, 1))
+    , freeList(nullptr)
+    , numAllocated(0)
+{
+    // Keep all blocks aligned to the maximum alignment.
+    const size_t align = alignof(std::max_align_t);
+    blockSize = (blockSize + align - 1) / align * align;
+}
+
+void* MemoryPool::Allocate()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!freeList) {
+        AddChunk();
+    }
+
+    FreeBlock* block = freeList;
+    freeList = block->next;
+    ++numAllocated;
+    return block;
+}
+
+void MemoryPool::Deallocate(void* p)
+{
+    if (!p) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    assert(numAllocated > 0);
+    FreeBlock* block = static_cast<FreeBlock*>(p);
+    block->next = freeList;
+    freeList = block;
+    --numAllocated;
+}
+
+void MemoryPool::AllocateBatch(void** blocks, size_t n)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < n; ++i) {
+        if (!freeList) {
+            AddChunk();
+        }
+        blocks[i] = freeList;
+        freeList = freeList->next;
+    }
+    numAllocated += n;
+}
+
+void MemoryPool::DeallocateBatch(void* const* blocks, size_t n)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    assert(numAllocated >= n);
+    for (size_t i = 0; i < n; ++i) {
+        FreeBlock* block = static_cast<FreeBlock*>(blocks[i]);
+        block->next = freeList;
+        freeList = block;
+    }
+    numAllocated -= n;
+}
+
+size_t MemoryPool::GetNumAllocated() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return numAllocated;
+}
+
+size_t MemoryPool::GetCapacity() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return chunks.size() * blocksPerChunk;
+}
+
+void MemoryPool::AddChunk()
+{
+    const size_t bytes = blockSize * blocksPerChunk;
+    const size_t n = (bytes + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+    chunks.push_back(std::unique_ptr<std::max_align_t[]>(new std::max_align_t[n]));
+
+    // Link the blocks in address order, the first block is used first.
+    char* first = reinterpret_cast<char*>(chunks.back().get());
+    for (size_t i = blocksPerChunk; i-- > 0; ) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(first + i * blockSize);
+        block->next = freeList;
+        freeList = block;
+    }
+}
+
+MemoryPoolCache::MemoryPoolCache(MemoryPool & p, MemoryPoolCache* & r)
+    : pool(p)
+    , registration(r)
+    , numCached(0)
+{
+    registration = this;
+}
+
+MemoryPoolCache::~MemoryPoolCache()
+{
+    pool.DeallocateBatch(cached, numCached);
+    registration = nullptr;
+}
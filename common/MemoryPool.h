@@ -0,0 +1,200 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+
+/**
+ * A thread-safe pool of memory blocks of equal size.
+ * 
+ * Memory is reserved in chunks holding a number of blocks. Released blocks
+ * are kept in a free list and reused by subsequent allocations; chunks are
+ * only returned to the system when the pool is destroyed.
+ */
+class MemoryPool {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param blockSize         the size of each block in bytes
+     * @param blocksPerChunk    the number of blocks reserved at once
+     */
+    MemoryPool(size_t blockSize, size_t blocksPerChunk = 1024);
+
+    MemoryPool(const MemoryPool &) = delete;
+    MemoryPool & operator=(const MemoryPool &) = delete;
+
+    /**
+     * Allocates a block.
+     * 
+     * @return the allocated block
+     */
+    void* Allocate();
+
+    /**
+     * Returns a block to this pool.
+     * 
+     * @param p the block, must have been allocated by this pool
+     */
+    void Deallocate(void* p);
+
+    /**
+     * Allocates several blocks at once, locking the pool only once.
+     * 
+     * @param blocks    receives the allocated blocks
+     * @param n         the number of blocks to allocate
+     */
+    void AllocateBatch(void** blocks, size_t n);
+
+    /**
+     * Returns several blocks at once, locking the pool only once.
+     * 
+     * @param blocks    the blocks, must have been allocated by this pool
+     * @param n         the number of blocks
+     */
+    void DeallocateBatch(void* const* blocks, size_t n);
+
+    /**
+     * Returns the size of the blocks.
+     * 
+     * @return the block size in bytes
+     */
+    size_t GetBlockSize() const {
+        return blockSize;
+    }
+
+    /**
+     * Returns the number of allocated blocks.
+     * 
+     * @return the number of blocks in use, including cached blocks
+     */
+    size_t GetNumAllocated() const;
+
+    /**
+     * Returns the number of reserved blocks.
+     * 
+     * @return the number of blocks in use or in the free list
+     */
+    size_t GetCapacity() const;
+
+private:
+    /** A released block, links to the next released block. */
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    /** The size of each block in bytes. */
+    size_t blockSize;
+
+    /** The number of blocks reserved at once. */
+    size_t blocksPerChunk;
+
+    /** The reserved chunks. */
+    std::vector<std::unique_ptr<std::max_align_t[]>> chunks;
+
+    /** The first released block. */
+    FreeBlock* freeList;
+
+    /** The number of allocated blocks. */
+    size_t numAllocated;
+
+    /** Guards the free list and the chunks. */
+    mutable std::mutex mutex;
+
+    void AddChunk();
+};
+
+/**
+ * A small cache of free blocks in front of a shared memory pool.
+ * 
+ * Each thread is supposed to use a cache of its own, hence the cache is
+ * not thread-safe. Blocks are taken from and returned to the pool in 
+ * batches, so the pool is locked only once per batch. Blocks may be
+ * returned to the cache of another thread than the one which allocated
+ * them. The remaining blocks are returned to the pool when the cache is
+ * destroyed, hence the pool must outlive the cache.
+ * 
+ * The cache registers itself in a pointer provided by its owner and
+ * resets that pointer when being destroyed, which allows to detect the
+ * destruction of thread-local caches.
+ */
+class MemoryPoolCache {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param pool          the pool this cache takes its blocks from
+     * @param registration  points to this cache while it exists
+     */
+    MemoryPoolCache(MemoryPool & pool, MemoryPoolCache* & registration);
+
+    /**
+     * Destructor, returns all cached blocks to the pool.
+     */
+    ~MemoryPoolCache();
+
+    MemoryPoolCache(const MemoryPoolCache &) = delete;
+    MemoryPoolCache & operator=(const MemoryPoolCache &) = delete;
+
+    /**
+     * Allocates a block.
+     * 
+     * @return the allocated block
+     */
+    void* Allocate() {
+        if (numCached == 0) {
+            pool.AllocateBatch(cached, BATCH_SIZE);
+            numCached = BATCH_SIZE;
+        }
+        return cached[--numCached];
+    }
+
+    /**
+     * Returns a block to this cache.
+     * 
+     * @param p the block, must have been allocated by the pool of this cache
+     */
+    void Deallocate(void* p) {
+        if (!p) {
+            return;
+        }
+        if (numCached == CAPACITY) {
+            numCached -= BATCH_SIZE;
+            pool.DeallocateBatch(cached + numCached, BATCH_SIZE);
+        }
+        cached[numCached++] = p;
+    }
+
+private:
+    /** The number of blocks taken from or returned to the pool at once. */
+    static constexpr size_t BATCH_SIZE = 32;
+
+    /** The maximum number of cached blocks. */
+    static constexpr size_t CAPACITY = 2 * BATCH_SIZE;
+
+    /** The pool this cache takes its blocks from. */
+    MemoryPool & pool;
+
+    /** Points to this cache while it exists. */
+    MemoryPoolCache* & registration;
+
+    /** The cached free blocks. */
+    void* cached[CAPACITY];
+
+    /** The number of cached blocks. */
+    size_t numCached;
+};
@@ -0,0 +1,82 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <cassert>
+#include "NetBuffer.h"
+
+void OutputBuffer::WriteUInt16(uint16_t value)
+{
+    data.push_back(static_cast<uint8_t>(value));
+    data.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void OutputBuffer::WriteUInt32(uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) {
+        data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void OutputBuffer::WriteVarUInt(uint32_t value)
+{
+    while (value >= 0x80) {
+        data.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<uint8_t>(value));
+}
+
+void OutputBuffer::PatchUInt16(size_t pos, uint16_t value)
+{
+    assert(pos + 2 <= data.size());
+    data[pos] = static_cast<uint8_t>(value);
+    data[pos + 1] = static_cast<uint8_t>(value >> 8);
+}
+
+uint8_t InputBuffer::ReadUInt8()
+{
+    if (pos >= size) {
+        valid = false;
+        return 0;
+    }
+    return data[pos++];
+}
+
+uint16_t InputBuffer::ReadUInt16()
+{
+    uint16_t value = ReadUInt8();
+    return value | static_cast<uint16_t>(ReadUInt8() << 8);
+}
+
+uint32_t InputBuffer::ReadUInt32()
+{
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(ReadUInt8()) << (8 * i);
+    }
+    return value;
+}
+
+uint32_t InputBuffer::ReadVarUInt()
+{
+    uint32_t value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        uint8_t byte = ReadUInt8();
+        value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+
+    // More than five bytes, the data is malformed.
+    valid = false;
+    return 0;
+}
@@ -0,0 +1,214 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Serializes values into a compact binary representation.
+ * 
+ * Multi-byte values are written in little endian byte order. Variable
+ * length integers use seven bits per byte, hence small values, e.g., small
+ * deltas, take only a single byte.
+ */
+class OutputBuffer {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param capacity  the number of bytes to reserve memory for
+     */
+    OutputBuffer(size_t capacity = 1500) {
+        data.reserve(capacity);
+    }
+
+    /**
+     * Writes an unsigned 8-bit value.
+     * 
+     * @param value the value to write
+     */
+    void WriteUInt8(uint8_t value) {
+        data.push_back(value);
+    }
+
+    /**
+     * Writes an unsigned 16-bit value.
+     * 
+     * @param value the value to write
+     */
+    void WriteUInt16(uint16_t value);
+
+    /**
+     * Writes an unsigned 32-bit value.
+     * 
+     * @param value the value to write
+     */
+    void WriteUInt32(uint32_t value);
+
+    /**
+     * Writes an unsigned value using a variable number of bytes.
+     * 
+     * @param value the value to write
+     */
+    void WriteVarUInt(uint32_t value);
+
+    /**
+     * Writes a signed value using a variable number of bytes.
+     * Values close to zero take few bytes, regardless of the sign.
+     * 
+     * @param value the value to write
+     */
+    void WriteVarInt(int32_t value) {
+        WriteVarUInt((static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+    }
+
+    /**
+     * Overwrites an unsigned 16-bit value which has been written before.
+     * 
+     * @param pos   the position of the value in bytes
+     * @param value the new value
+     */
+    void PatchUInt16(size_t pos, uint16_t value);
+
+    /**
+     * Discards all written bytes.
+     */
+    void Clear() {
+        data.clear();
+    }
+
+    /**
+     * Discards bytes written after a certain position.
+     * 
+     * @param pos   the number of bytes to keep
+     */
+    void Truncate(size_t pos) {
+        data.resize(pos);
+    }
+
+    /**
+     * Returns the number of written bytes.
+     * 
+     * @return the size of the buffer in bytes
+     */
+    size_t GetSize() const {
+        return data.size();
+    }
+
+    /**
+     * Returns the written bytes.
+     * 
+     * @return the data of this buffer
+     */
+    const uint8_t* GetData() const {
+        return data.data();
+    }
+
+private:
+    /** The written bytes. */
+    std::vector<uint8_t> data;
+};
+
+/**
+ * Deserializes values written by an output buffer.
+ * 
+ * Reading beyond the end of the data yields zero values and marks the
+ * buffer invalid, so malformed packets can be rejected after decoding
+ * instead of checking each single read operation.
+ */
+class InputBuffer {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param data  the data to read from
+     * @param size  the size of the data in bytes
+     */
+    InputBuffer(const uint8_t* data, size_t size)
+        : data(data), size(size), pos(0), valid(true)
+    {
+        // Intentionally left empty.
+    }
+
+    /**
+     * Reads an unsigned 8-bit value.
+     * 
+     * @return the value read
+     */
+    uint8_t ReadUInt8();
+
+    /**
+     * Reads an unsigned 16-bit value.
+     * 
+     * @return the value read
+     */
+    uint16_t ReadUInt16();
+
+    /**
+     * Reads an unsigned 32-bit value.
+     * 
+     * @return the value read
+     */
+    uint32_t ReadUInt32();
+
+    /**
+     * Reads an unsigned value written with a variable number of bytes.
+     * 
+     * @return the value read
+     */
+    uint32_t ReadVarUInt();
+
+    /**
+     * Reads a signed value written with a variable number of bytes.
+     * 
+     * @return the value read
+     */
+    int32_t ReadVarInt() {
+        uint32_t value = ReadVarUInt();
+        return static_cast<int32_t>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    /**
+     * Tests whether all read operations stayed within the data.
+     * 
+     * @return `true` if the data read so far is valid
+     */
+    bool IsValid() const {
+        return valid;
+    }
+
+    /**
+     * Tests whether all data has been read.
+     * 
+     * @return `true` if no data is left
+     */
+    bool IsAtEnd() const {
+        return pos >= size;
+    }
+
+private:
+    /** The data to read from. */
+    const uint8_t* data;
+
+    /** The size of the data in bytes. */
+    size_t size;
+
+    /** The current read position. */
+    size_t pos;
+
+    /** Whether all read operations stayed within the data. */
+    bool valid;
+};
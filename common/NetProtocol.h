@@ -0,0 +1,138 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "NetBuffer.h"
+
+/** The types of messages exchanged between server and clients. */
+enum class MessageType : uint8_t {
+    /** Sent by clients to join the server, repeated until snapshots arrive. */
+    HELLO,
+
+    /** Sent by the server, contains a delta-encoded snapshot. */
+    SNAPSHOT,
+
+    /** Sent by clients, acknowledges the latest received snapshot. */
+    ACK,
+
+    /** Sent by clients, contains the player inputs not yet processed. */
+    INPUT,
+
+    /** Sent by clients when leaving the server. */
+    BYE,
+};
+
+/**
+ * Information sent to each client along with the snapshots.
+ * 
+ * The state of the player entity is sent separately from the snapshot,
+ * since snapshots may be truncated, while clients need the exact state
+ * matching the last processed input to reconcile their prediction.
+ */
+struct ClientInfo {
+    /** The number of server ticks per second. */
+    uint16_t tickRate;
+
+    /** The network id of the entity controlled by the client. */
+    uint32_t playerId;
+
+    /** The sequence number of the last player input processed. */
+    uint32_t lastInput;
+
+    /** The quantized position of the player entity. */
+    int32_t playerX, playerY;
+
+    /** The quantized orientation of the player entity. */
+    uint16_t playerAngle;
+
+    /**
+     * Writes this information.
+     * 
+     * @param out   the buffer to write to
+     */
+    void Write(OutputBuffer & out) const {
+        out.WriteVarUInt(tickRate);
+        out.WriteVarUInt(playerId);
+        out.WriteUInt32(lastInput);
+        out.WriteVarInt(playerX);
+        out.WriteVarInt(playerY);
+        out.WriteUInt16(playerAngle);
+    }
+
+    /**
+     * Reads this information.
+     * 
+     * @param in    the buffer to read from
+     * @return `true` on success
+     */
+    bool Read(InputBuffer & in) {
+        tickRate = static_cast<uint16_t>(in.ReadVarUInt());
+        playerId = in.ReadVarUInt();
+        lastInput = in.ReadUInt32();
+        playerX = in.ReadVarInt();
+        playerY = in.ReadVarInt();
+        playerAngle = in.ReadUInt16();
+        return in.IsValid() && tickRate > 0;
+    }
+};
+
+/**
+ * Constants and message headers of the Bagaga network protocol.
+ * 
+ * Each datagram starts with the protocol id, followed by the message type.
+ * Datagrams with a different protocol id are ignored. Snapshot messages
+ * contain the client information followed by the encoded snapshot, input 
+ * messages the sequence number of the first input, the number of inputs
+ * and the inputs with variable length coordinates.
+ */
+class NetProtocol {
+public:
+
+    /** Identifies datagrams of the Bagaga protocol. */
+    static constexpr uint32_t PROTOCOL_ID = 0xBA6A6A01;
+
+    /** The UDP port the server listens on by default. */
+    static constexpr uint16_t DEFAULT_PORT = 7777;
+
+    /** The maximum size of a datagram, small enough to avoid fragmentation. */
+    static constexpr size_t MAX_PACKET_SIZE = 1200;
+
+    /** The maximum number of player inputs sent within one message. */
+    static constexpr size_t MAX_INPUTS_PER_MESSAGE = 16;
+
+    /**
+     * Writes the header of a message.
+     * 
+     * @param out   the buffer to write to
+     * @param type  the type of the message
+     */
+    static void WriteHeader(OutputBuffer & out, MessageType type) {
+        out.WriteUInt32(PROTOCOL_ID);
+        out.WriteUInt8(static_cast<uint8_t>(type));
+    }
+
+    /**
+     * Reads the header of a message.
+     * 
+     * @param in    the buffer to read from
+     * @param type  receives the type of the message
+     * @return `true` if the message belongs to this protocol
+     */
+    static bool ReadHeader(InputBuffer & in, MessageType & type) {
+        const uint32_t id = in.ReadUInt32();
+        const uint8_t t = in.ReadUInt8();
+        type = static_cast<MessageType>(t);
+        return in.IsValid() && id == PROTOCOL_ID && t <= static_cast<uint8_t>(MessageType::BYE);
+    }
+};
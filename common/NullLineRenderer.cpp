@@ -0,0 +1,59 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include "NullLineRenderer.h"
+
+NullLineRenderer::NullLineRenderer()
+    : BaseService("Null Line Renderer")
+    , numLines(0)
+    , numColorChanges(0)
+{
+    // Intentionally left empty.
+}
+
+void NullLineRenderer::ResetCounters()
+{
+    numLines = 0;
+    numColorChanges = 0;
+}
+
+void NullLineRenderer::DrawLine(double x1, double y1, double x2, double y2)
+{
+    ++numLines;
+}
+
+void NullLineRenderer::DrawLineStrip(const astu::Vector2<double>* points, size_t n, bool closed)
+{
+    if (n < 2) {
+        return;
+    }
+    numLines += closed && n > 2 ? n : n - 1;
+}
+
+void NullLineRenderer::DrawLines(const astu::Vector2<double>* points, size_t n)
+{
+    numLines += n / 2;
+}
+
+void NullLineRenderer::SetDrawColor(const astu::Color & c)
+{
+    ++numColorChanges;
+}
+
+void NullLineRenderer::OnStartup()
+{
+    ResetCounters();
+}
+
+void NullLineRenderer::OnShutdown()
+{
+    // Intentionally left empty.
+}
@@ -0,0 +1,73 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <Service.h>
+#include "ILineRenderer.h"
+
+/**
+ * An implementation of the ILineRenderer interface which draws nothing.
+ * 
+ * This service only counts the render calls and is used to run the
+ * simulation without a window, e.g., for benchmarks.
+ */
+class NullLineRenderer : public astu::BaseService, public ILineRenderer {
+public:
+
+    /**
+     * Constructor.
+     */
+    NullLineRenderer();
+
+    /**
+     * Returns the number of lines drawn since the last reset.
+     * 
+     * @return the number of lines
+     */
+    size_t GetNumLines() const {
+        return numLines;
+    }
+
+    /**
+     * Returns the number of color changes since the last reset.
+     * 
+     * @return the number of color changes
+     */
+    size_t GetNumColorChanges() const {
+        return numColorChanges;
+    }
+
+    /**
+     * Resets the counters to zero.
+     */
+    void ResetCounters();
+
+    // Inherited via ILineRenderer
+    virtual void DrawLine(double x1, double y1, double x2, double X2) override;
+    virtual void DrawLineStrip(const astu::Vector2<double>* points, size_t n, bool closed = false) override;
+    virtual void DrawLines(const astu::Vector2<double>* points, size_t n) override;
+    virtual void SetDrawColor(const astu::Color & c) override;
+
+protected:
+
+    // Inherited via BaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+
+private:
+    /** The number of lines drawn. */
+    size_t numLines;
+
+    /** The number of color changes. */
+    size_t numColorChanges;
+};
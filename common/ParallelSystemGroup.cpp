@@ -0,0 +1,95 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include "FrameProfiler.h"
+#include "ParallelSystemGroup.h"
+
+ParallelSystemGroup::ParallelSystemGroup(int priority)
+    : UpdatableBaseService("Parallel System Group", priority)
+{
+    // Intentionally left empty.
+}
+
+void ParallelSystemGroup::AddSystem(std::shared_ptr<BatchEntitySystem> system)
+{
+    systems.push_back(system);
+}
+
+void ParallelSystemGroup::OnStartup()
+{
+    jobSystem = GetSM().FindService<JobSystem>();
+
+    timeService = GetSM().FindService<astu::ITimeService>();
+    if (!timeService) {
+        throw std::logic_error("Time service required for " + GetName());
+    }
+
+    // Each system goes to the phase after the last conflicting system.
+    std::vector<size_t> phaseOf(systems.size());
+    for (size_t i = 0; i < systems.size(); ++i) {
+        size_t phase = 0;
+        for (size_t j = 0; j < i; ++j) {
+            if (systems[i]->GetComponentAccess().ConflictsWith(systems[j]->GetComponentAccess())) {
+                phase = std::max(phase, phaseOf[j] + 1);
+            }
+        }
+        phaseOf[i] = phase;
+
+        if (phases.size() <= phase) {
+            phases.resize(phase + 1);
+        }
+        phases[phase].push_back(systems[i].get());
+        systems[i]->grouped = true;
+    }
+}
+
+void ParallelSystemGroup::OnShutdown()
+{
+    for (auto & system : systems) {
+        system->grouped = false;
+    }
+    phases.clear();
+    jobSystem = nullptr;
+    timeService = nullptr;
+}
+
+void ParallelSystemGroup::OnUpdate()
+{
+    if (!IsStepped()) {
+        Execute(timeService->GetElapsedTime());
+    }
+}
+
+void ParallelSystemGroup::OnFixedStep(double dt)
+{
+    Execute(dt);
+}
+
+void ParallelSystemGroup::Execute(double dt)
+{
+    BAGAGA_PROFILE_SCOPE(GetName().c_str());
+    for (auto & phase : phases) {
+        if (!jobSystem || phase.size() == 1) {
+            for (auto system : phase) {
+                system->Execute(dt);
+            }
+            continue;
+        }
+
+        JobCounter counter;
+        for (auto system : phase) {
+            jobSystem->Submit([system, dt]() { system->Execute(dt); }, counter);
+        }
+        jobSystem->Wait(counter);
+    }
+}
@@ -0,0 +1,81 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <UpdateService.h>
+#include <ITimeService.h>
+#include "BatchEntitySystem.h"
+#include "FixedStepSystem.h"
+#include "JobSystem.h"
+
+/**
+ * Executes a group of batch entity systems, running systems with
+ * non-conflicting component accesses at the same time.
+ * 
+ * The systems must also be added as services, but are no longer updated
+ * on their own while being part of a started group. Systems conflicting
+ * with each other are executed in the order they have been passed to the
+ * group. All systems of the group have finished when the group's update
+ * returns, hence services updated later on never run concurrently to them.
+ * 
+ * The group can be stepped by a FixedStepService as a whole.
+ */
+class ParallelSystemGroup : public astu::UpdatableBaseService, public FixedStepSystem {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param priority  the update priority of this service
+     */
+    ParallelSystemGroup(int priority = 0);
+
+    /**
+     * Adds a system to this group. Systems must be added before the group
+     * is started.
+     * 
+     * @param system    the system to add
+     */
+    void AddSystem(std::shared_ptr<BatchEntitySystem> system);
+
+protected:
+
+    // Inherited via UpdatableBaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+    virtual void OnUpdate() override;
+
+    // Inherited via FixedStepSystem
+    virtual void OnFixedStep(double dt) override;
+
+private:
+    /** The systems of this group. */
+    std::vector<std::shared_ptr<BatchEntitySystem>> systems;
+
+    /** Systems grouped into phases of mutually non-conflicting systems. */
+    std::vector<std::vector<BatchEntitySystem*>> phases;
+
+    /** The optional job system used to run the systems of a phase. */
+    std::shared_ptr<JobSystem> jobSystem;
+
+    /** Used for fast access to time service. */
+    std::shared_ptr<astu::ITimeService> timeService;
+
+    /**
+     * Executes all systems of this group.
+     * 
+     * @param dt    the elapsed time in seconds
+     */
+    void Execute(double dt);
+};
@@ -0,0 +1,61 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+/**
+ * Base class for systems which update the simulation or record render
+ * calls and can be run by a FramePipeline on its worker thread.
+ * 
+ * Systems run by a started FramePipeline must not do their work in their
+ * regular update. Derived systems are expected to check IsPipelined() in
+ * their update and to do the work of one frame in OnPipelinedUpdate().
+ */
+class PipelinedSystem {
+public:
+
+    /**
+     * Virtual destructor.
+     */
+    virtual ~PipelinedSystem() {}
+
+    /**
+     * Tests whether this system is run by a frame pipeline.
+     * 
+     * @return `true` if this system is pipelined
+     */
+    bool IsPipelined() const {
+        return pipelined;
+    }
+
+protected:
+
+    /**
+     * Constructor.
+     */
+    PipelinedSystem()
+        : pipelined(false)
+    {
+        // Intentionally left empty.
+    }
+
+    /**
+     * Does the work of one frame, called on the worker thread of the
+     * frame pipeline.
+     */
+    virtual void OnPipelinedUpdate() = 0;
+
+private:
+    /** Whether this system is run by a frame pipeline. */
+    bool pipelined;
+
+    friend class FramePipeline;
+};
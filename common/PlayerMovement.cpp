@@ -0,0 +1,39 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <cmath>
+#include "Snapshot.h"
+#include "PlayerMovement.h"
+
+#define MAX_SPEED 300.0
+
+using namespace astu;
+
+void PlayerMovement::Step(Pose2D & pose, const PlayerInput & input, double dt)
+{
+    Vector2<double> d(
+        SnapshotCodec::DequantizePosition(input.targetX) - pose.pos.x,
+        SnapshotCodec::DequantizePosition(input.targetY) - pose.pos.y);
+
+    const double dist = std::sqrt(d.LengthSquared());
+    if (dist == 0) {
+        return;
+    }
+
+    // Face the target and stop exactly on it.
+    pose.angle = std::atan2(d.y, d.x);
+    const double step = MAX_SPEED * dt;
+    if (dist <= step) {
+        pose.pos += d;
+    } else {
+        pose.pos += d * (step / dist);
+    }
+}
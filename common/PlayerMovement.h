@@ -0,0 +1,47 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <Vector2.h>
+#include "Pose2D.h"
+
+/**
+ * The input of a player for a single server tick.
+ */
+struct PlayerInput {
+    /** The quantized x-coordinate of the target, see SnapshotCodec. */
+    int32_t targetX;
+
+    /** The quantized y-coordinate of the target, see SnapshotCodec. */
+    int32_t targetY;
+};
+
+/**
+ * Moves player-controlled entities towards their targets.
+ * 
+ * The movement is deterministic and depends on the input only, hence the
+ * server and the predicting client yield the same result. Both must step
+ * with the duration of a server tick.
+ */
+class PlayerMovement {
+public:
+
+    /**
+     * Moves a player for one tick.
+     * 
+     * @param pose  the pose of the player
+     * @param input the input of the player
+     * @param dt    the duration of a tick in seconds
+     */
+    static void Step(Pose2D & pose, const PlayerInput & input, double dt);
+};
@@ -23,10 +23,20 @@ public:
     const std::shared_ptr<Polygon> polygon;
     bool closed;
 
+    /** The vertices in world space, cached by the polyline visual system. */
+    Polygon worldVertices;
+
+    /** The position the cached world space vertices are based on. */
+    astu::Vector2<double> cachedPos;
+
+    /** The orientation the cached world space vertices are based on. */
+    double cachedAngle;
+
     Polyline(const std::shared_ptr<Polygon> poly, const astu::Color & c = astu::WebColors::Red, bool _closed = true)
         : color(c)
         , polygon(poly)
         , closed(_closed)
+        , cachedAngle(0)
     {
         // Intentionally left empty.
     }
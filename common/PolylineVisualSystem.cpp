@@ -9,18 +9,23 @@
  * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
  */
 
+#define _USE_MATH_DEFINES
 #include <stdexcept>
 #include <cassert>
+#include <cmath>
 #include "Pose2D.h"
 #include "Polyline.h"
+#include "FrameProfiler.h"
 #include "PolylineVisualSystem.h"
 
 using namespace astu;
 
 const EntityFamily PolylineVisualSystem::FAMILY = EntityFamily::Create<Pose2D, Polyline>();
+const EntityFamily PolylineVisualSystem::DENSE_FAMILY = EntityFamily::Create<DenseSlot, Polyline>();
 
 PolylineVisualSystem::PolylineVisualSystem(int priority)
-    : IteratingEntitySystem(FAMILY, priority, "Polyline Visual System")
+    : UpdatableBaseService("Polyline Visual System", priority)
+    , alpha(1)
 {
     // Intentionally left empty.
 }
@@ -31,42 +36,118 @@ void PolylineVisualSystem::OnStartup()
     if (!renderer) {
         throw std::logic_error("ILineRenderer required for Polyline Visual System");
     }
+
+    auto & es = GetSM().GetService<EntityService>();
+    entityView = es.GetEntityView(FAMILY);
+
+    store = GetSM().FindService<SoaComponentStore>();
+    if (store) {
+        denseView = es.GetEntityView(DENSE_FAMILY);
+    }
+
+    fixedStep = GetSM().FindService<FixedStepService>();
 }
 
 void PolylineVisualSystem::OnShutdown()
 {
     renderer = nullptr;
+    entityView = nullptr;
+    denseView = nullptr;
+    store = nullptr;
+    fixedStep = nullptr;
+}
+
+void PolylineVisualSystem::OnUpdate()
+{
+    if (!IsPipelined()) {
+        Render();
+    }
 }
 
+void PolylineVisualSystem::OnPipelinedUpdate()
+{
+    Render();
+}
+
+void PolylineVisualSystem::Render()
+{
+    BAGAGA_PROFILE_SCOPE_COUNT(GetName().c_str(), entityView->size() + (denseView ? denseView->size() : 0));
+    alpha = fixedStep ? fixedStep->GetInterpolationFactor() : 1;
+    for (size_t i = 0; i < entityView->size(); ++i) {
+        ProcessEntity(*(*entityView)[i]);
+    }
+
+    if (denseView) {
+        for (size_t i = 0; i < denseView->size(); ++i) {
+            ProcessDenseEntity(*(*denseView)[i]);
+        }
+    }
+}
 
 void PolylineVisualSystem::ProcessEntity(Entity & e)
 {
     auto & pose = e.GetComponent<Pose2D>();
     auto  & poly = e.GetComponent<Polyline>();
 
+    if (fixedStep) {
+        DrawPolyline(poly, 
+            Pose2D::Interpolate(pose.prevPos, pose.pos, alpha), 
+            Pose2D::InterpolateAngle(pose.prevAngle, pose.angle, alpha));
+    } else {
+        DrawPolyline(poly, pose.pos, pose.angle);
+    }
+}
+
+void PolylineVisualSystem::ProcessDenseEntity(Entity & e)
+{
+    const size_t slot = e.GetComponent<DenseSlot>().GetSlot();
+    auto  & poly = e.GetComponent<Polyline>();
+
+    const Vector2<double> pos(store->posX[slot], store->posY[slot]);
+    if (fixedStep) {
+        const Vector2<double> prevPos(store->prevPosX[slot], store->prevPosY[slot]);
+        DrawPolyline(poly, 
+            Pose2D::Interpolate(prevPos, pos, alpha), 
+            Pose2D::InterpolateAngle(store->prevAngle[slot], store->angle[slot], alpha));
+    } else {
+        DrawPolyline(poly, pos, store->angle[slot]);
+    }
+}
+
+void PolylineVisualSystem::DrawPolyline(Polyline & poly, const Vector2<double> & pos, double angle)
+{
     renderer->SetDrawColor(poly.color);
 
-    auto & polygon = *poly.polygon;
-    assert(polygon.size() >= 2);
+    UpdateWorldVertices(poly, pos, angle);
+    const auto & vertices = poly.worldVertices;
+    assert(vertices.size() >= 2);
 
-    Vector2<double>* ptr = polygon.data();
-    Vector2<double> p1 = *ptr++;
-    p1.Rotate(pose.angle);
-    p1 += pose.pos;
+    renderer->DrawLineStrip(vertices.data(), vertices.size(), poly.closed);
+}
 
-    for (size_t i = 0; i < polygon.size() - 1; ++i) {
-        Vector2 p2 = *ptr++;
-        p2.Rotate(pose.angle);
-        p2 += pose.pos;
-        renderer->DrawLine(p1, p2);
-        p1 = p2;
+void PolylineVisualSystem::UpdateWorldVertices(Polyline & poly, const Vector2<double> & pos, double angle)
+{
+    const auto & polygon = *poly.polygon;
+    auto & vertices = poly.worldVertices;
+
+    // Static entities keep their transformed vertices.
+    if (vertices.size() == polygon.size() 
+        && poly.cachedPos.x == pos.x 
+        && poly.cachedPos.y == pos.y 
+        && poly.cachedAngle == angle) 
+    {
+        return;
     }
 
-    if (poly.closed) {
-        Vector2 p2 = *polygon.data();
-        p2.Rotate(pose.angle);
-        p2 += pose.pos;
-        renderer->DrawLine(p1, p2);
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+
+    vertices.resize(polygon.size());
+    for (size_t i = 0; i < polygon.size(); ++i) {
+        const auto & v = polygon[i];
+        vertices[i].Set(v.x * c - v.y * s + pos.x, v.x * s + v.y * c + pos.y);
     }
 
+    poly.cachedPos = pos;
+    poly.cachedAngle = angle;
 }
@@ -11,10 +11,23 @@
 
 #pragma once
 
-#include <IteratingEntitySystem.h>
+#include <UpdateService.h>
+#include <EntityService.h>
+#include "SoaComponentStore.h"
 #include "ILineRenderer.h"
+#include "FixedStepService.h"
+#include "PipelinedSystem.h"
 
-class PolylineVisualSystem : public astu::IteratingEntitySystem {
+class Polyline;
+
+/**
+ * Renders the polylines of entities.
+ * 
+ * If the simulation is advanced by a FixedStepService, the entities are
+ * rendered in between their previous and current poses. The system can
+ * be run on the worker thread of a FramePipeline.
+ */
+class PolylineVisualSystem : public astu::UpdatableBaseService, public PipelinedSystem {
 public:
 
     /**
@@ -26,15 +39,42 @@ public:
 
 protected:
 
-        // Inherited via IteratingEntitySystem
+        // Inherited via UpdatableBaseService
         virtual void OnStartup() override;
         virtual void OnShutdown() override;
-        virtual void ProcessEntity(astu::Entity & e) override;
+        virtual void OnUpdate() override;
+
+        // Inherited via PipelinedSystem
+        virtual void OnPipelinedUpdate() override;
 
 private:
     /** A constant describing the family of entities this system processes. */
     static const astu::EntityFamily FAMILY;
 
+    /** A constant describing the family of entities kept in the dense store. */
+    static const astu::EntityFamily DENSE_FAMILY;
+
+    /** The view to the entities to be processed. */
+    std::shared_ptr<astu::EntityView> entityView;
+
+    /** The view to the entities kept in the dense store, if any. */
+    std::shared_ptr<astu::EntityView> denseView;
+
+    /** The optional dense component store. */
+    std::shared_ptr<SoaComponentStore> store;
+
     /** The line renderer used to render the visuals. */
     std::shared_ptr<ILineRenderer> renderer;
-};
\ No newline at end of file
+
+    /** The optional fixed step service advancing the simulation. */
+    std::shared_ptr<FixedStepService> fixedStep;
+
+    /** The interpolation factor between previous and current poses. */
+    double alpha;
+
+    void Render();
+    void ProcessEntity(astu::Entity & e);
+    void ProcessDenseEntity(astu::Entity & e);
+    void DrawPolyline(Polyline & poly, const astu::Vector2<double> & pos, double angle);
+    void UpdateWorldVertices(Polyline & poly, const astu::Vector2<double> & pos, double angle);
+};
@@ -0,0 +1,108 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <new>
+#include <cstddef>
+#include "MemoryPool.h"
+
+/**
+ * Returns the memory pool for objects of the specified type.
+ * 
+ * Each type has a pool of its own. The pools are never destroyed, so
+ * objects may outlive static destruction.
+ * 
+ * @tparam T    the type of the pooled objects
+ * @return the memory pool
+ */
+template <typename T>
+MemoryPool & GetTypedPool() {
+    static MemoryPool* pool = new MemoryPool(sizeof(T));
+    return *pool;
+}
+
+/**
+ * Returns the cache of the current thread in front of the memory pool
+ * for objects of the specified type.
+ * 
+ * Objects might be released after the cache has been destroyed at thread
+ * exit, e.g., during static destruction. The plain registration pointer
+ * stays valid in that case and the pool must be used directly.
+ * 
+ * @tparam T    the type of the pooled objects
+ * @return the cache of the current thread, null if already destroyed
+ */
+template <typename T>
+MemoryPoolCache* GetTypedPoolCache() {
+    static thread_local MemoryPoolCache* current = nullptr;
+    static thread_local bool created = false;
+    if (!created) {
+        created = true;
+        static thread_local MemoryPoolCache cache(GetTypedPool<T>(), current);
+    }
+    return current;
+}
+
+/**
+ * A standard allocator which takes single objects from a memory pool.
+ * 
+ * Use it with std::allocate_shared to place the object and its reference
+ * count within one pooled block. The allocator is rebound to the type of
+ * that block, which is distinct for each object type, hence each type is
+ * taken from a pool of its own. Single objects go through a thread-local
+ * cache, so threads spawning in bursts rarely contend for the pool.
+ * Arrays are allocated from the heap.
+ * 
+ * @tparam T    the type of the allocated objects
+ */
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+    T* allocate(size_t n) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types can not be pooled");
+        if (n != 1) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        MemoryPoolCache* cache = GetTypedPoolCache<T>();
+        return static_cast<T*>(cache ? cache->Allocate() : GetTypedPool<T>().Allocate());
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (n != 1) {
+            ::operator delete(p);
+            return;
+        }
+        MemoryPoolCache* cache = GetTypedPoolCache<T>();
+        if (cache) {
+            cache->Deallocate(p);
+        } else {
+            GetTypedPool<T>().Deallocate(p);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U> &) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U> &) const noexcept {
+        return false;
+    }
+};
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#define _USE_MATH_DEFINES
+#include <cmath>
 #include <EntityService.h>
 #include <Vector2.h>
 
@@ -19,9 +21,17 @@ public:
     astu::Vector2<double> pos;
     double angle;
 
+    /** The position before the last fixed simulation step. */
+    astu::Vector2<double> prevPos;
+
+    /** The orientation before the last fixed simulation step. */
+    double prevAngle;
+
     Pose2D(double x = 0, double y = 0, double a = 0)
         : pos(x, y)
         , angle(a)
+        , prevPos(x, y)
+        , prevAngle(a)
     {
         // Intentionally left empty.            
     }
@@ -29,7 +39,59 @@ public:
    Pose2D(const astu::Vector2<double> & p, double a = 0)
         : pos(p)
         , angle(a)
+        , prevPos(p)
+        , prevAngle(a)
     {
         // Intentionally left empty.            
     }
+
+    /**
+     * Sets this pose in between two other poses.
+     * 
+     * The position is interpolated linearly, the orientation takes the 
+     * shorter way around the circle.
+     * 
+     * @param a the pose at t = 0
+     * @param b the pose at t = 1
+     * @param t the interpolation parameter within [0, 1]
+     */
+    void SetInterpolated(const Pose2D & a, const Pose2D & b, double t) {
+        pos = Interpolate(a.pos, b.pos, t);
+        angle = InterpolateAngle(a.angle, b.angle, t);
+    }
+
+    /**
+     * Interpolates linearly between two positions.
+     * 
+     * @param a the position at t = 0
+     * @param b the position at t = 1
+     * @param t the interpolation parameter within [0, 1]
+     * @return the interpolated position
+     */
+    static astu::Vector2<double> Interpolate(
+        const astu::Vector2<double> & a, const astu::Vector2<double> & b, double t) 
+    {
+        return a + (b - a) * t;
+    }
+
+    /**
+     * Interpolates between two orientations the shorter way around the circle.
+     * 
+     * @param a the orientation at t = 0
+     * @param b the orientation at t = 1
+     * @param t the interpolation parameter within [0, 1]
+     * @return the interpolated orientation
+     */
+    static double InterpolateAngle(double a, double b, double t) {
+        return a + std::remainder(b - a, 2 * M_PI) * t;
+    }
+
+    /**
+     * Saves the current pose as previous pose. Called before the pose
+     * gets advanced by a fixed simulation step.
+     */
+    void SavePrevious() {
+        prevPos = pos;
+        prevAngle = angle;
+    }
 };
\ No newline at end of file
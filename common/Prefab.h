@@ -0,0 +1,85 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <EntityService.h>
+#include "EntityFactory.h"
+
+/**
+ * A named template for entities, made of component prototypes.
+ * 
+ * Each instance of a prefab receives copies of the prototypes, allocated
+ * by the entity factory. Instances are usually spawned in batches using
+ * the PrefabService.
+ */
+class Prefab {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param name  the name of this prefab
+     */
+    Prefab(const std::string & _name)
+        : name(_name)
+    {
+        // Intentionally left empty.
+    }
+
+    /**
+     * Returns the name of this prefab.
+     * 
+     * @return the name
+     */
+    const std::string & GetName() const {
+        return name;
+    }
+
+    /**
+     * Adds a component prototype.
+     * 
+     * @tparam T        the type of the component, must be copy constructible
+     * @param prototype the prototype copied to each instance
+     * @return reference to this prefab for method chaining
+     */
+    template <typename T>
+    Prefab & Add(const T & prototype) {
+        cloners.push_back([prototype]() -> std::shared_ptr<astu::EntityComponent> {
+            return EntityFactory::CreateComponent<T>(prototype);
+        });
+        return *this;
+    }
+
+    /**
+     * Creates a new entity with copies of all component prototypes.
+     * 
+     * @return the new entity
+     */
+    std::shared_ptr<astu::Entity> Instantiate() const {
+        auto entity = EntityFactory::CreateEntity();
+        for (const auto & clone : cloners) {
+            entity->AddComponent(clone());
+        }
+        return entity;
+    }
+
+private:
+    /** The name of this prefab. */
+    std::string name;
+
+    /** Create the copies of the component prototypes. */
+    std::vector<std::function<std::shared_ptr<astu::EntityComponent>()>> cloners;
+};
@@ -0,0 +1,86 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <stdexcept>
+#include "Pose2D.h"
+#include "PrefabService.h"
+
+using namespace astu;
+
+PrefabService::PrefabService()
+    : BaseService("Prefab Service")
+{
+    // Intentionally left empty.
+}
+
+void PrefabService::AddPrefab(std::shared_ptr<Prefab> prefab)
+{
+    prefabs[prefab->GetName()] = prefab;
+}
+
+bool PrefabService::HasPrefab(const std::string & name) const
+{
+    return prefabs.find(name) != prefabs.end();
+}
+
+const Prefab & PrefabService::GetPrefab(const std::string & name) const
+{
+    auto it = prefabs.find(name);
+    if (it == prefabs.end()) {
+        throw std::logic_error("Unknown prefab '" + name + "'");
+    }
+    return *it->second;
+}
+
+void PrefabService::SpawnBatch(
+    const Prefab & prefab, 
+    size_t count, 
+    const Initializer & initializer, 
+    std::vector<std::shared_ptr<Entity>>* out)
+{
+    batch.clear();
+    batch.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        batch.push_back(prefab.Instantiate());
+        auto & entity = *batch.back();
+        if (initializer) {
+            initializer(entity, i);
+        }
+
+        // Instances start at their initialized pose instead of being 
+        // interpolated from the pose of the prefab.
+        if (entity.HasComponent<Pose2D>()) {
+            entity.GetComponent<Pose2D>().SavePrevious();
+        }
+    }
+
+    auto & es = GetSM().GetService<EntityService>();
+    for (const auto & entity : batch) {
+        es.AddEntity(entity);
+    }
+
+    if (out) {
+        out->insert(out->end(), batch.begin(), batch.end());
+    }
+    batch.clear();
+}
+
+void PrefabService::OnStartup()
+{
+    // Intentionally left empty.
+}
+
+void PrefabService::OnShutdown()
+{
+    prefabs.clear();
+    batch.clear();
+    batch.shrink_to_fit();
+}
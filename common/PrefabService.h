@@ -0,0 +1,109 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include <Service.h>
+#include <EntityService.h>
+#include "Prefab.h"
+
+/**
+ * Keeps named prefabs and spawns batches of their instances.
+ */
+class PrefabService : public astu::BaseService {
+public:
+
+    /** Customizes the spawned entity with the specified index within the batch. */
+    using Initializer = std::function<void(astu::Entity &, size_t)>;
+
+    /**
+     * Constructor.
+     */
+    PrefabService();
+
+    /**
+     * Adds a prefab, replacing a prefab with the same name.
+     * 
+     * @param prefab    the prefab to add
+     */
+    void AddPrefab(std::shared_ptr<Prefab> prefab);
+
+    /**
+     * Tests whether a prefab with the specified name exists.
+     * 
+     * @param name  the name of the prefab
+     * @return `true` if the prefab exists
+     */
+    bool HasPrefab(const std::string & name) const;
+
+    /**
+     * Returns the prefab with the specified name.
+     * 
+     * @param name  the name of the prefab
+     * @return the prefab
+     * @throws std::logic_error in case the prefab does not exist
+     */
+    const Prefab & GetPrefab(const std::string & name) const;
+
+    /**
+     * Spawns a number of instances of a prefab.
+     * 
+     * All instances are created and initialized first and then added to
+     * the entity service in one pass. The previous pose of each instance
+     * is set to its initialized pose.
+     * 
+     * @param prefab        the prefab to instantiate
+     * @param count         the number of instances
+     * @param initializer   customizes each instance, may be empty
+     * @param out           receives the spawned entities, may be `nullptr`
+     */
+    void SpawnBatch(
+        const Prefab & prefab, 
+        size_t count, 
+        const Initializer & initializer = nullptr, 
+        std::vector<std::shared_ptr<astu::Entity>>* out = nullptr);
+
+    /**
+     * Spawns a number of instances of a named prefab.
+     * 
+     * @param name          the name of the prefab to instantiate
+     * @param count         the number of instances
+     * @param initializer   customizes each instance, may be empty
+     * @param out           receives the spawned entities, may be `nullptr`
+     * @throws std::logic_error in case the prefab does not exist
+     */
+    void SpawnBatch(
+        const std::string & name, 
+        size_t count, 
+        const Initializer & initializer = nullptr, 
+        std::vector<std::shared_ptr<astu::Entity>>* out = nullptr)
+    {
+        SpawnBatch(GetPrefab(name), count, initializer, out);
+    }
+
+protected:
+
+    // Inherited via BaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+
+private:
+    /** The prefabs by name. */
+    std::unordered_map<std::string, std::shared_ptr<Prefab>> prefabs;
+
+    /** The entities of the current batch, kept to reuse its memory. */
+    std::vector<std::shared_ptr<astu::Entity>> batch;
+};
@@ -0,0 +1,122 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include "ProfilerOverlay.h"
+
+/** The width of the frame budget in pixels. */
+#define BUDGET_WIDTH 200.0
+
+/** The height of a bar in pixels. */
+#define BAR_HEIGHT 4
+
+/** The vertical distance between two bars in pixels. */
+#define BAR_SPACING 6.0
+
+/** The height of the frame graph in pixels. */
+#define GRAPH_HEIGHT 40.0
+
+using namespace astu;
+
+static const Color kBarColors[] = {
+    WebColors::Red, 
+    WebColors::Green, 
+    WebColors::Blue, 
+    WebColors::Yellow, 
+    WebColors::White,
+};
+
+ProfilerOverlay::ProfilerOverlay(double x, double y, double b, int priority)
+    : UpdatableBaseService("Profiler Overlay", priority)
+    , x0(x)
+    , y0(y)
+    , budget(b * 1e9)
+{
+    // Intentionally left empty.
+}
+
+void ProfilerOverlay::OnStartup()
+{
+    renderer = GetSM().FindService<ILineRenderer>();
+    if (!renderer) {
+        throw std::logic_error("ILineRenderer required for Profiler Overlay");
+    }
+
+    profiler = GetSM().FindService<FrameProfiler>();
+    if (!profiler) {
+        throw std::logic_error("Frame profiler required for Profiler Overlay");
+    }
+}
+
+void ProfilerOverlay::OnShutdown()
+{
+    renderer = nullptr;
+    profiler = nullptr;
+    bars.clear();
+    graph.clear();
+}
+
+void ProfilerOverlay::OnUpdate()
+{
+    if (profiler->GetNumFrames() == 0) {
+        return;
+    }
+
+    // Accumulate the time per scope, batches executed in parallel add up.
+    const auto & frame = profiler->GetFrame(0);
+    bars.clear();
+    for (size_t i = 0; i < frame.GetNumSamples(); ++i) {
+        const auto & sample = frame.samples[i];
+        auto it = std::find_if(bars.begin(), bars.end(), [&sample](const Bar & bar) {
+            return std::strcmp(bar.name, sample.name) == 0;
+        });
+        if (it == bars.end()) {
+            bars.push_back({sample.name, sample.duration});
+        } else {
+            it->duration += sample.duration;
+        }
+    }
+
+    const double scale = BUDGET_WIDTH / budget;
+    double y = y0;
+    for (size_t i = 0; i < bars.size(); ++i) {
+        renderer->SetDrawColor(kBarColors[i % (sizeof(kBarColors) / sizeof(kBarColors[0]))]);
+        DrawBar(y, bars[i].duration * scale);
+        y += BAR_SPACING;
+    }
+
+    // Mark the frame budget.
+    renderer->SetDrawColor(WebColors::White);
+    renderer->DrawLine(x0 + BUDGET_WIDTH, y0 - 2, x0 + BUDGET_WIDTH, y);
+
+    // Draw the durations of the recent frames, the budget at half height.
+    y += GRAPH_HEIGHT;
+    const size_t numFrames = profiler->GetNumFrames();
+    const double dx = BUDGET_WIDTH / numFrames;
+    graph.clear();
+    for (size_t age = numFrames; age-- > 0; ) {
+        double h = std::min(profiler->GetFrame(age).duration / budget * 0.5, 1.0) * GRAPH_HEIGHT;
+        graph.push_back(Vector2<double>(x0 + (numFrames - 1 - age) * dx, y - h));
+    }
+    renderer->DrawLine(x0, y - GRAPH_HEIGHT * 0.5, x0 + BUDGET_WIDTH, y - GRAPH_HEIGHT * 0.5);
+    renderer->SetDrawColor(WebColors::Yellow);
+    renderer->DrawLineStrip(graph.data(), graph.size());
+}
+
+void ProfilerOverlay::DrawBar(double y, double length)
+{
+    length = std::max(length, 1.0);
+    for (int i = 0; i < BAR_HEIGHT; ++i) {
+        renderer->DrawLine(x0, y + i, x0 + length, y + i);
+    }
+}
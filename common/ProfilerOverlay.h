@@ -0,0 +1,77 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <UpdateService.h>
+#include "ILineRenderer.h"
+#include "FrameProfiler.h"
+
+/**
+ * Draws the measurements of the frame profiler using lines.
+ * 
+ * For the most recently completed frame, the time spent in each profiled
+ * scope is shown as a horizontal bar, one color per scope in the order of
+ * their first appearance. A vertical line marks the frame budget. Below
+ * the bars, the durations of the recent frames are shown as a graph.
+ */
+class ProfilerOverlay : public astu::UpdatableBaseService {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param x         the x-coordinate of the upper left corner
+     * @param y         the y-coordinate of the upper left corner
+     * @param budget    the frame budget in seconds
+     * @param priority  the update priority of this service
+     */
+    ProfilerOverlay(double x = 10, double y = 10, double budget = 1.0 / 60.0, int priority = 0);
+
+protected:
+
+    // Inherited via UpdatableBaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+    virtual void OnUpdate() override;
+
+private:
+    /** The accumulated time of a profiled scope. */
+    struct Bar {
+        const char* name;
+        int64_t duration;
+    };
+
+    /** The x-coordinate of the upper left corner. */
+    double x0;
+
+    /** The y-coordinate of the upper left corner. */
+    double y0;
+
+    /** The frame budget in nanoseconds. */
+    double budget;
+
+    /** The profiler to visualize. */
+    std::shared_ptr<FrameProfiler> profiler;
+
+    /** The renderer used to draw the overlay. */
+    std::shared_ptr<ILineRenderer> renderer;
+
+    /** The bars of the current frame, kept to reuse their memory. */
+    std::vector<Bar> bars;
+
+    /** The points of the frame graph, kept to reuse their memory. */
+    std::vector<astu::Vector2<double>> graph;
+
+    void DrawBar(double y, double length);
+};
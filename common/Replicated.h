@@ -0,0 +1,49 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <EntityService.h>
+#include <Color.h>
+
+/**
+ * Marks an entity to be replicated from the server to the clients.
+ * 
+ * The position, orientation and velocity of the entity are taken from its
+ * Pose2D and LinearMovement components or from the dense component store.
+ */
+class Replicated : public astu::EntityComponent {
+public:
+    /** The network id, unique among the replicated entities of a match. */
+    uint32_t id;
+
+    /** The shape of the entity, see ShapeCatalog. */
+    uint16_t shape;
+
+    /** The color of the entity. */
+    astu::Color color;
+
+    /**
+     * Constructor.
+     * 
+     * @param id    the network id
+     * @param shape the shape of the entity
+     * @param c     the color of the entity
+     */
+    Replicated(uint32_t id, uint16_t shape, const astu::Color & c)
+        : id(id)
+        , shape(shape)
+        , color(c)
+    {
+        // Intentionally left empty.
+    }
+};
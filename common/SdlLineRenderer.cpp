@@ -13,47 +13,103 @@
 #include <SDL2/SDL.h>
 #include "SdlLineRenderer.h"
 
+/** The initial draw color, opaque white. */
+#define DEFAULT_COLOR 0xffffffff
 
 SdlLineRenderer::SdlLineRenderer(int renderPriority)
     : astu::BaseSdlRenderLayer(renderPriority, "SDL Line Renderer")
+    , recordFrame(0)
+    , replayFrame(1)
+    , readyFrame(2)
+    , autoSubmit(true)
+    , currentColor(DEFAULT_COLOR)
+    , currentBucket(0)
 {
-    // Intenitonally left empty.
+    // Render calls may be recorded before the render layer is started.
+    currentBucket = frames[recordFrame].GetBucket(currentColor);
+}
+
+void SdlLineRenderer::SubmitFrame()
+{
+    // Colors not used by the submitted frame are dropped, the others keep
+    // their memory once the frame comes back for recording.
+    frames[recordFrame].RemoveUnusedBuckets();
+    recordFrame = readyFrame.exchange(recordFrame | FRESH_BIT, std::memory_order_acq_rel) & ~FRESH_BIT;
+    frames[recordFrame].Clear();
+    currentBucket = frames[recordFrame].GetBucket(currentColor);
 }
 
 void SdlLineRenderer::OnRender(SDL_Renderer* renderer)
 {
-    for (auto const & cmd : commands) {
-        switch (cmd.type) {
-        case CommandType::DRAW_LINE:
-            SDL_RenderDrawLine(renderer, cmd.line.x1, cmd.line.y1, cmd.line.x2, cmd.line.y2);
-            break;
-
-        case CommandType::SET_COLOR:
-            SDL_SetRenderDrawColor(
-                renderer,
-                static_cast<uint8_t>(cmd.color.r), 
-                static_cast<uint8_t>(cmd.color.g), 
-                static_cast<uint8_t>(cmd.color.b), 
-                static_cast<uint8_t>(cmd.color.a)
-                );
-            break;
+    if (autoSubmit) {
+        SubmitFrame();
+    }
+
+    // Without a new frame, the previous frame is replayed again.
+    if (readyFrame.load(std::memory_order_relaxed) & FRESH_BIT) {
+        replayFrame = readyFrame.exchange(replayFrame, std::memory_order_acq_rel) & ~FRESH_BIT;
+    }
+
+    for (const auto & bucket : frames[replayFrame].buckets) {
+        if (bucket.lines.empty() && bucket.stripSizes.empty()) {
+            continue;
+        }
+
+        SDL_SetRenderDrawColor(
+            renderer,
+            static_cast<uint8_t>(bucket.color >> 24), 
+            static_cast<uint8_t>(bucket.color >> 16), 
+            static_cast<uint8_t>(bucket.color >> 8), 
+            static_cast<uint8_t>(bucket.color)
+            );
+
+        const SDL_FPoint* strip = bucket.strips.data();
+        for (int n : bucket.stripSizes) {
+            SDL_RenderDrawLinesF(renderer, strip, n);
+            strip += n;
+        }
+
+        for (size_t i = 0; i + 1 < bucket.lines.size(); i += 2) {
+            const SDL_FPoint & p1 = bucket.lines[i];
+            const SDL_FPoint & p2 = bucket.lines[i + 1];
+            SDL_RenderDrawLineF(renderer, p1.x, p1.y, p2.x, p2.y);
         }
     }
-    commands.clear();
 }
 
 void SdlLineRenderer::DrawLine(double x1, double y1, double x2, double y2)
 {
+    auto & lines = GetCurrentBucket().lines;
+    lines.push_back(ToPoint(astu::Vector2<double>(x1, y1)));
+    lines.push_back(ToPoint(astu::Vector2<double>(x2, y2)));
+}
+
+void SdlLineRenderer::DrawLineStrip(const astu::Vector2<double>* p, size_t n, bool closed)
+{
+    if (n < 2) {
+        return;
+    }
 
-    RenderCommand cmd;
+    auto & bucket = GetCurrentBucket();
+    for (size_t i = 0; i < n; ++i) {
+        bucket.strips.push_back(ToPoint(p[i]));
+    }
+    if (closed && n > 2) {
+        bucket.strips.push_back(ToPoint(p[0]));
+        ++n;
+    }
+    bucket.stripSizes.push_back(static_cast<int>(n));
+}
 
-    cmd.type = CommandType::DRAW_LINE;
-    cmd.line.x1 = static_cast<int>(x1);
-    cmd.line.y1 = static_cast<int>(y1);
-    cmd.line.x2 = static_cast<int>(x2);
-    cmd.line.y2 = static_cast<int>(y2);
+void SdlLineRenderer::DrawLines(const astu::Vector2<double>* p, size_t n)
+{
+    // Ignore the dangling point of an odd number of points.
+    n &= ~static_cast<size_t>(1);
 
-    commands.push_back(cmd);
+    auto & lines = GetCurrentBucket().lines;
+    for (size_t i = 0; i < n; ++i) {
+        lines.push_back(ToPoint(p[i]));
+    }
 }
 
 void SdlLineRenderer::SetDrawColor(const astu::Color & c) 
@@ -63,24 +119,70 @@ void SdlLineRenderer::SetDrawColor(const astu::Color & c)
     assert(c.b >= 0 && c.b <= 1);
     assert(c.a >= 0 && c.a <= 1);
 
-    RenderCommand cmd;
-    cmd.type = CommandType::SET_COLOR;
-    cmd.color.r = static_cast<int>(c.r * 255);
-    cmd.color.g = static_cast<int>(c.g * 255);
-    cmd.color.b = static_cast<int>(c.b * 255);
-    cmd.color.a = static_cast<int>(c.a * 255);
+    uint32_t color = static_cast<uint32_t>(c.r * 255) << 24
+        | static_cast<uint32_t>(c.g * 255) << 16
+        | static_cast<uint32_t>(c.b * 255) << 8
+        | static_cast<uint32_t>(c.a * 255);
 
-    commands.push_back(cmd);
+    // Redundant color changes, e.g., one per entity, are dropped here.
+    if (color != currentColor) {
+        currentColor = color;
+        currentBucket = frames[recordFrame].GetBucket(color);
+    }
 }
 
 void SdlLineRenderer::OnStartup()
 {
-    // Intentionally left empty.
+    currentBucket = frames[recordFrame].GetBucket(currentColor);
 }
 
 void SdlLineRenderer::OnShutdown()
 {
-    commands.clear();
-    commands.resize(0);
-    commands.shrink_to_fit();
-}
\ No newline at end of file
+    for (auto & frame : frames) {
+        frame.buckets.clear();
+        frame.buckets.shrink_to_fit();
+        frame.bucketLookup.clear();
+    }
+}
+
+size_t SdlLineRenderer::Frame::GetBucket(uint32_t color)
+{
+    auto it = bucketLookup.find(color);
+    if (it != bucketLookup.end()) {
+        return it->second;
+    }
+
+    size_t idx = buckets.size();
+    buckets.push_back(ColorBucket());
+    buckets.back().color = color;
+    bucketLookup[color] = idx;
+    return idx;
+}
+
+void SdlLineRenderer::Frame::RemoveUnusedBuckets()
+{
+    size_t dst = 0;
+    for (size_t src = 0; src < buckets.size(); ++src) {
+        auto & bucket = buckets[src];
+        if (bucket.lines.empty() && bucket.stripSizes.empty()) {
+            bucketLookup.erase(bucket.color);
+            continue;
+        }
+
+        if (dst != src) {
+            buckets[dst] = std::move(bucket);
+            bucketLookup[buckets[dst].color] = dst;
+        }
+        ++dst;
+    }
+    buckets.resize(dst);
+}
+
+void SdlLineRenderer::Frame::Clear()
+{
+    for (auto & bucket : buckets) {
+        bucket.lines.clear();
+        bucket.strips.clear();
+        bucket.stripSizes.clear();
+    }
+}
@@ -12,16 +12,32 @@
 #pragma once
 
 #include <SdlRenderService.h>
+#include <SDL2/SDL.h>
 #include <vector>
+#include <unordered_map>
+#include <atomic>
 #include <cstdint>
 #include "ILineRenderer.h"
 
 /**
  * A SDL-based implementation of the ILineRenderer interface.
  * 
- * This service is a SDL render layer and uses the command design pattern
- * to store the render calls and replays them when the render layer should
- * be rendered.
+ * This service is a SDL render layer and records the render calls, which
+ * are replayed when the render layer should be rendered. Lines are sorted
+ * into buckets by color and stored as packed float coordinates. Each
+ * bucket is replayed with a single color change, line strips with a single
+ * SDL call each. Setting the current color again has no effect.
+ * 
+ * Recording and replay use separate frames of a triple buffer. Once a
+ * frame has been recorded, it is handed over to the replay side by
+ * calling SubmitFrame, which requires no locks and never blocks. Replay
+ * always uses the most recently submitted frame and repeats the previous
+ * one if no new frame has been submitted. Only the replay must happen on
+ * the thread driving the SDL render service, render calls can be recorded
+ * on any single thread, e.g., by the worker of a FramePipeline.
+ * 
+ * By default, OnRender submits the recorded frame itself, which is the
+ * right choice when recording and replay happen on the same thread.
  */
 class SdlLineRenderer : public astu::BaseSdlRenderLayer, public ILineRenderer {
 public:
@@ -38,11 +54,32 @@ public:
      */
     virtual ~SdlLineRenderer() {}
 
+    /**
+     * Hands the recorded frame over to the replay side and starts
+     * recording the next frame.
+     * 
+     * Must be called by the thread which records the render calls, after
+     * the frame has been completely recorded.
+     */
+    void SubmitFrame();
+
+    /**
+     * Specifies whether OnRender submits the recorded frame. Must not be
+     * changed while render calls are recorded on another thread.
+     * 
+     * @param b `true` to submit the recorded frame on each OnRender
+     */
+    void SetAutoSubmit(bool b) {
+        autoSubmit = b;
+    }
+
     // Inherited via BaseSdlRenderLayer
     virtual void OnRender(SDL_Renderer* renderer) override;
 
     // Inherited via ILineRenderer
     virtual void DrawLine(double x1, double y1, double x2, double X2) override;
+    virtual void DrawLineStrip(const astu::Vector2<double>* points, size_t n, bool closed = false) override;
+    virtual void DrawLines(const astu::Vector2<double>* points, size_t n) override;
     virtual void SetDrawColor(const astu::Color & c) override;
 
 protected:
@@ -53,26 +90,66 @@ protected:
 
 private:
 
-    /** Enumeration for types of render commands. */
-    enum CommandType {DRAW_LINE, SET_COLOR};
+    /** The lines recorded for one color. */
+    struct ColorBucket {
+        /** The color as packed RGBA value. */
+        uint32_t color;
 
-    struct DrawLineCommand {
-        CommandType type;
-        int x1, y1, x2, y2;
-    };
+        /** The end points of independent lines, two per line. */
+        std::vector<SDL_FPoint> lines;
+
+        /** The points of all line strips, one strip after the other. */
+        std::vector<SDL_FPoint> strips;
 
-    struct SetColorCommand {
-        CommandType type;
-        int r, g, b, a;
+        /** The number of points of each line strip. */
+        std::vector<int> stripSizes;
     };
 
-    /** Union holding data for all types of render commands. */
-    union RenderCommand {
-        CommandType type;
-        DrawLineCommand line;
-        SetColorCommand color;
+    /** The recorded lines of one frame. */
+    struct Frame {
+        /** The color buckets, kept across frames to reuse their memory. */
+        std::vector<ColorBucket> buckets;
+
+        /** Maps packed colors to bucket indices. */
+        std::unordered_map<uint32_t, size_t> bucketLookup;
+
+        size_t GetBucket(uint32_t color);
+        void RemoveUnusedBuckets();
+        void Clear();
     };
 
-    // /** The current render commands to be processed. */
-    std::vector<RenderCommand> commands;
+    /** Marks the ready frame as not yet replayed. */
+    static const uint32_t FRESH_BIT = 4;
+
+    /** The frames of the triple buffer. */
+    Frame frames[3];
+
+    /** The index of the frame being recorded. */
+    uint32_t recordFrame;
+
+    /** The index of the frame being replayed. */
+    uint32_t replayFrame;
+
+    /** The index of the frame ready to be replayed and the fresh bit. */
+    std::atomic<uint32_t> readyFrame;
+
+    /** Whether OnRender submits the recorded frame. */
+    bool autoSubmit;
+
+    /** The packed current draw color. */
+    uint32_t currentColor;
+
+    /** The index of the bucket of the current draw color. */
+    size_t currentBucket;
+
+    ColorBucket & GetCurrentBucket() {
+        return frames[recordFrame].buckets[currentBucket];
+    }
+
+    static SDL_FPoint ToPoint(const astu::Vector2<double> & p) {
+        SDL_FPoint result;
+        result.x = static_cast<float>(p.x);
+        result.y = static_cast<float>(p.y);
+        return result;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,39 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <algorithm>
+#include "ShapeCatalog.h"
+
+#define NUM_SEGMENTS 15
+
+using namespace astu;
+
+uint16_t ShapeCatalog::GetCircleId(double radius)
+{
+    return static_cast<uint16_t>(std::max(1.0, std::min(std::round(radius), 65535.0)));
+}
+
+const std::shared_ptr<Polyline::Polygon> & ShapeCatalog::GetShape(uint16_t id)
+{
+    auto & shape = shapes[id];
+    if (!shape) {
+        shape = std::make_shared<Polyline::Polygon>();
+        double da = (2 * M_PI) / NUM_SEGMENTS;
+        for (int i = 0; i < NUM_SEGMENTS; ++i) {
+            Vector2<double> v(id, 0);
+            v.Rotate(da * i);
+            shape->push_back(v);
+        }
+    }
+    return shape;
+}
@@ -0,0 +1,49 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "Polyline.h"
+
+/**
+ * Maps the shape ids used by the network protocol to polygons.
+ * 
+ * Shape ids denote circles, the id being the radius in world units. 
+ * Polygons are created on first use and shared by all entities of the
+ * same shape.
+ */
+class ShapeCatalog {
+public:
+
+    /**
+     * Returns the shape id of a circle.
+     * 
+     * @param radius    the radius of the circle in world units
+     * @return the shape id
+     */
+    static uint16_t GetCircleId(double radius);
+
+    /**
+     * Returns the polygon of a shape.
+     * 
+     * @param id    the shape id
+     * @return the polygon of the shape
+     */
+    const std::shared_ptr<Polyline::Polygon> & GetShape(uint16_t id);
+
+private:
+    /** The polygons created so far. */
+    std::unordered_map<uint16_t, std::shared_ptr<Polyline::Polygon>> shapes;
+};
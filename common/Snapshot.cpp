@@ -0,0 +1,311 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include "Snapshot.h"
+
+#define POSITION_SCALE 16.0
+#define ANGLE_SCALE (65536.0 / (2 * M_PI))
+#define MAX_VAR_UINT_SIZE 5
+
+using namespace astu;
+
+static bool ById(const EntityState & a, const EntityState & b)
+{
+    return a.id < b.id;
+}
+
+static int32_t Delta(int32_t a, int32_t b)
+{
+    return static_cast<int32_t>(static_cast<uint32_t>(a) - static_cast<uint32_t>(b));
+}
+
+static int32_t Apply(int32_t base, int32_t delta)
+{
+    return static_cast<int32_t>(static_cast<uint32_t>(base) + static_cast<uint32_t>(delta));
+}
+
+static size_t GetVarUIntSize(uint32_t value)
+{
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+const EntityState* Snapshot::Find(uint32_t id) const
+{
+    EntityState key = {};
+    key.id = id;
+    auto it = std::lower_bound(entities.begin(), entities.end(), key, ById);
+    return it != entities.end() && it->id == id ? &*it : nullptr;
+}
+
+uint8_t SnapshotCodec::GetChangedFields(const EntityState & a, const EntityState & b)
+{
+    uint8_t flags = 0;
+    if (a.x != b.x || a.y != b.y) {
+        flags |= POSITION;
+    }
+    if (a.angle != b.angle) {
+        flags |= ANGLE;
+    }
+    if (a.vx != b.vx || a.vy != b.vy) {
+        flags |= VELOCITY;
+    }
+    if (a.shape != b.shape || a.color != b.color) {
+        flags |= VISUAL;
+    }
+    return flags;
+}
+
+int32_t SnapshotCodec::QuantizePosition(double v)
+{
+    const double q = std::round(v * POSITION_SCALE);
+    return static_cast<int32_t>(std::max(
+        static_cast<double>(std::numeric_limits<int32_t>::min()), 
+        std::min(q, static_cast<double>(std::numeric_limits<int32_t>::max()))));
+}
+
+uint16_t SnapshotCodec::QuantizeAngle(double a)
+{
+    double turns = std::fmod(a, 2 * M_PI);
+    if (turns < 0) {
+        turns += 2 * M_PI;
+    }
+    return static_cast<uint16_t>(static_cast<uint32_t>(std::lround(turns * ANGLE_SCALE)) & 0xffff);
+}
+
+double SnapshotCodec::DequantizeAngle(uint16_t q)
+{
+    return q / ANGLE_SCALE;
+}
+
+uint32_t SnapshotCodec::QuantizeColor(const Color & c)
+{
+    auto channel = [](double v) {
+        return static_cast<uint32_t>(std::lround(std::max(0.0, std::min(v, 1.0)) * 255));
+    };
+    return channel(c.r) << 24 | channel(c.g) << 16 | channel(c.b) << 8 | channel(c.a);
+}
+
+Color SnapshotCodec::DequantizeColor(uint32_t q)
+{
+    Color c;
+    c.r = (q >> 24) / 255.0;
+    c.g = ((q >> 16) & 0xff) / 255.0;
+    c.b = ((q >> 8) & 0xff) / 255.0;
+    c.a = (q & 0xff) / 255.0;
+    return c;
+}
+
+void SnapshotCodec::Encode(
+    const Snapshot & current, 
+    const Snapshot & baseline, 
+    size_t budget,
+    uint32_t & cursor,
+    OutputBuffer & out, 
+    Snapshot & sent)
+{
+    out.WriteUInt32(current.sequence);
+    out.WriteUInt32(baseline.sequence);
+    out.WriteUInt32(current.tick);
+
+    // Entities of the baseline which no longer exist are removed as far as
+    // the budget allows, leaving room for both counts. Removals which do not
+    // fit keep their baseline state and are sent with one of the next
+    // snapshots.
+    sent.sequence = current.sequence;
+    sent.tick = current.tick;
+    sent.entities.clear();
+    size_t removedSize = out.GetSize() + MAX_VAR_UINT_SIZE + sizeof(uint16_t);
+    uint32_t numRemoved = 0;
+    uint32_t prevId = 0;
+    bool full = false;
+    for (const auto & state : baseline.entities) {
+        if (current.Find(state.id)) {
+            sent.entities.push_back(state);
+            continue;
+        }
+
+        const size_t size = GetVarUIntSize(state.id - prevId);
+        full = full || removedSize + size > budget;
+        if (full) {
+            sent.entities.push_back(state);
+            continue;
+        }
+        removedSize += size;
+        prevId = state.id;
+        ++numRemoved;
+    }
+
+    out.WriteVarUInt(numRemoved);
+    prevId = 0;
+    uint32_t numWritten = 0;
+    for (const auto & state : baseline.entities) {
+        if (numWritten == numRemoved) {
+            break;
+        }
+        if (!current.Find(state.id)) {
+            out.WriteVarUInt(state.id - prevId);
+            prevId = state.id;
+            ++numWritten;
+        }
+    }
+
+    // Encode changes round-robin starting at the cursor, so entities 
+    // which did not fit into previous snapshots are sent first.
+    const size_t countPos = out.GetSize();
+    out.WriteUInt16(0);
+
+    EntityState key = {};
+    key.id = cursor;
+    const size_t n = current.entities.size();
+    const size_t first = std::lower_bound(current.entities.begin(), current.entities.end(), key, ById) 
+        - current.entities.begin();
+
+    const size_t numKept = sent.entities.size();
+    const EntityState blank = {};
+    uint16_t numChanged = 0;
+    prevId = 0;
+    for (size_t k = 0; k < n; ++k) {
+        const auto & state = current.entities[(first + k) % n];
+        const EntityState* base = baseline.Find(state.id);
+        if (!base) {
+            base = &blank;
+        }
+
+        uint8_t flags = GetChangedFields(state, *base);
+        if (!flags && base != &blank) {
+            continue;
+        }
+
+        if (out.GetSize() + MAX_ENTITY_SIZE > budget || numChanged == std::numeric_limits<uint16_t>::max()) {
+            cursor = state.id;
+            break;
+        }
+
+        out.WriteVarInt(Delta(state.id, prevId));
+        out.WriteUInt8(flags);
+        if (flags & POSITION) {
+            out.WriteVarInt(Delta(state.x, base->x));
+            out.WriteVarInt(Delta(state.y, base->y));
+        }
+        if (flags & ANGLE) {
+            out.WriteVarInt(static_cast<int16_t>(state.angle - base->angle));
+        }
+        if (flags & VELOCITY) {
+            out.WriteVarInt(Delta(state.vx, base->vx));
+            out.WriteVarInt(Delta(state.vy, base->vy));
+        }
+        if (flags & VISUAL) {
+            out.WriteVarUInt(state.shape);
+            out.WriteUInt32(state.color);
+        }
+
+        FindOrAppend(sent, numKept, state.id) = state;
+        prevId = state.id;
+        ++numChanged;
+    }
+
+    out.PatchUInt16(countPos, numChanged);
+    SortEntities(sent);
+}
+
+bool SnapshotCodec::DecodeHeader(InputBuffer & in, uint32_t & sequence, uint32_t & baseline)
+{
+    sequence = in.ReadUInt32();
+    baseline = in.ReadUInt32();
+    return in.IsValid() && sequence != NO_BASELINE;
+}
+
+bool SnapshotCodec::Decode(InputBuffer & in, uint32_t sequence, const Snapshot & baseline, Snapshot & out)
+{
+    out.sequence = sequence;
+    out.tick = in.ReadUInt32();
+    out.entities.clear();
+
+    // Removed entities, ids are sorted and encoded as gaps.
+    uint32_t numRemoved = in.ReadVarUInt();
+    uint32_t removedId = 0;
+    size_t idx = 0;
+    for (uint32_t i = 0; i < numRemoved && in.IsValid(); ++i) {
+        removedId += in.ReadVarUInt();
+        while (idx < baseline.entities.size() && baseline.entities[idx].id < removedId) {
+            out.entities.push_back(baseline.entities[idx++]);
+        }
+        if (idx < baseline.entities.size() && baseline.entities[idx].id == removedId) {
+            ++idx;
+        }
+    }
+    out.entities.insert(out.entities.end(), baseline.entities.begin() + idx, baseline.entities.end());
+
+    // Changed or new entities.
+    const size_t numKept = out.entities.size();
+    const uint16_t numChanged = in.ReadUInt16();
+    uint32_t id = 0;
+    for (uint16_t i = 0; i < numChanged && in.IsValid(); ++i) {
+        id = static_cast<uint32_t>(Apply(id, in.ReadVarInt()));
+        const uint8_t flags = in.ReadUInt8();
+
+        auto & state = FindOrAppend(out, numKept, id);
+        if (flags & POSITION) {
+            state.x = Apply(state.x, in.ReadVarInt());
+            state.y = Apply(state.y, in.ReadVarInt());
+        }
+        if (flags & ANGLE) {
+            state.angle = static_cast<uint16_t>(state.angle + in.ReadVarInt());
+        }
+        if (flags & VELOCITY) {
+            state.vx = Apply(state.vx, in.ReadVarInt());
+            state.vy = Apply(state.vy, in.ReadVarInt());
+        }
+        if (flags & VISUAL) {
+            state.shape = static_cast<uint16_t>(in.ReadVarUInt());
+            state.color = in.ReadUInt32();
+        }
+    }
+
+    if (!in.IsValid() || !in.IsAtEnd()) {
+        return false;
+    }
+    SortEntities(out);
+
+    // Reject snapshots listing an entity more than once.
+    auto sameId = [](const EntityState & a, const EntityState & b) {
+        return a.id == b.id;
+    };
+    return std::adjacent_find(out.entities.begin(), out.entities.end(), sameId) == out.entities.end();
+}
+
+void SnapshotCodec::SortEntities(Snapshot & snapshot)
+{
+    std::sort(snapshot.entities.begin(), snapshot.entities.end(), ById);
+}
+
+EntityState & SnapshotCodec::FindOrAppend(Snapshot & snapshot, size_t numSorted, uint32_t id)
+{
+    EntityState key = {};
+    key.id = id;
+    auto end = snapshot.entities.begin() + numSorted;
+    auto it = std::lower_bound(snapshot.entities.begin(), end, key, ById);
+    if (it != end && it->id == id) {
+        return *it;
+    }
+
+    snapshot.entities.push_back(key);
+    return snapshot.entities.back();
+}
@@ -0,0 +1,217 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <Vector2.h>
+#include <Color.h>
+
+#include "NetBuffer.h"
+
+/**
+ * The quantized state of a replicated entity.
+ */
+struct EntityState {
+    /** The network id of the entity. */
+    uint32_t id;
+
+    /** The quantized position, see SnapshotCodec::QuantizePosition. */
+    int32_t x, y;
+
+    /** The quantized orientation, see SnapshotCodec::QuantizeAngle. */
+    uint16_t angle;
+
+    /** The quantized velocity, see SnapshotCodec::QuantizePosition. */
+    int32_t vx, vy;
+
+    /** The shape of the entity, see ShapeCatalog. */
+    uint16_t shape;
+
+    /** The color of the entity as 8-bit RGBA values. */
+    uint32_t color;
+
+    bool operator==(const EntityState & o) const {
+        return id == o.id && x == o.x && y == o.y && angle == o.angle 
+            && vx == o.vx && vy == o.vy && shape == o.shape && color == o.color;
+    }
+};
+
+/**
+ * The state of all replicated entities at a certain server tick.
+ */
+struct Snapshot {
+    /** The sequence number of this snapshot, zero denotes no snapshot. */
+    uint32_t sequence = 0;
+
+    /** The server tick this snapshot has been taken at. */
+    uint32_t tick = 0;
+
+    /** The states of the entities, sorted by id. */
+    std::vector<EntityState> entities;
+
+    /**
+     * Searches the state of an entity.
+     * 
+     * @param id    the network id of the entity
+     * @return the state of the entity or null if not contained
+     */
+    const EntityState* Find(uint32_t id) const;
+};
+
+/**
+ * Encodes snapshots as deltas against a baseline snapshot.
+ * 
+ * Only entities which have been removed or have changed since the baseline
+ * are encoded, and only the fields which have changed. Numeric fields are
+ * written as small variable length deltas. Snapshots which exceed the size
+ * budget are truncated, the entities which did not fit keep their baseline
+ * state and are sent with one of the next snapshots.
+ */
+class SnapshotCodec {
+public:
+
+    /** Sequence number of the baseline if the receiver has no snapshot. */
+    static constexpr uint32_t NO_BASELINE = 0;
+
+    /** The maximum number of bytes of a single encoded entity. */
+    static constexpr size_t MAX_ENTITY_SIZE = 36;
+
+    /**
+     * Quantizes positions and velocities to 1/16 of a world unit.
+     * 
+     * @param v the value to quantize
+     * @return the quantized value
+     */
+    static int32_t QuantizePosition(double v);
+
+    /**
+     * Restores a position or velocity quantized before.
+     * 
+     * @param q the quantized value
+     * @return the restored value
+     */
+    static double DequantizePosition(int32_t q) {
+        return q / 16.0;
+    }
+
+    /**
+     * Quantizes an orientation to 1/65536 of a full turn.
+     * 
+     * @param a the orientation in radians
+     * @return the quantized orientation
+     */
+    static uint16_t QuantizeAngle(double a);
+
+    /**
+     * Restores an orientation quantized before.
+     * 
+     * @param q the quantized orientation
+     * @return the orientation in radians within [0, 2pi)
+     */
+    static double DequantizeAngle(uint16_t q);
+
+    /**
+     * Quantizes a color to 8-bit RGBA values.
+     * 
+     * @param c the color to quantize
+     * @return the quantized color
+     */
+    static uint32_t QuantizeColor(const astu::Color & c);
+
+    /**
+     * Restores a color quantized before.
+     * 
+     * @param q the quantized color
+     * @return the restored color
+     */
+    static astu::Color DequantizeColor(uint32_t q);
+
+    /**
+     * Encodes a snapshot as delta against a baseline.
+     * 
+     * @param current   the snapshot to encode
+     * @param baseline  the last snapshot acknowledged by the receiver
+     * @param budget    the maximum number of bytes to write
+     * @param cursor    the id to start encoding changes with, updated in
+     *                  case the snapshot gets truncated
+     * @param out       receives the encoded snapshot
+     * @param sent      receives the snapshot as decoded by the receiver
+     */
+    static void Encode(
+        const Snapshot & current, 
+        const Snapshot & baseline, 
+        size_t budget,
+        uint32_t & cursor,
+        OutputBuffer & out, 
+        Snapshot & sent);
+
+    /**
+     * Reads the sequence numbers of an encoded snapshot.
+     * 
+     * @param in        the encoded snapshot
+     * @param sequence  receives the sequence number of the snapshot
+     * @param baseline  receives the sequence number of the baseline
+     * @return `true` on success
+     */
+    static bool DecodeHeader(InputBuffer & in, uint32_t & sequence, uint32_t & baseline);
+
+    /**
+     * Decodes a snapshot, following its header.
+     * 
+     * @param in        the encoded snapshot
+     * @param sequence  the sequence number read from the header
+     * @param baseline  the baseline snapshot referenced by the header
+     * @param out       receives the decoded snapshot
+     * @return `true` on success, `false` if the data is malformed
+     */
+    static bool Decode(InputBuffer & in, uint32_t sequence, const Snapshot & baseline, Snapshot & out);
+
+private:
+
+    /** Flags describing which fields of an entity state are encoded. */
+    enum FieldFlags : uint8_t {
+        POSITION = 1,
+        ANGLE = 2,
+        VELOCITY = 4,
+        VISUAL = 8,
+    };
+
+    /**
+     * Determines the fields which differ between two entity states.
+     * 
+     * @param a the first entity state
+     * @param b the second entity state
+     * @return the field flags of the differing fields
+     */
+    static uint8_t GetChangedFields(const EntityState & a, const EntityState & b);
+
+    /**
+     * Sorts the entity states of a snapshot by id.
+     * 
+     * @param snapshot  the snapshot to sort
+     */
+    static void SortEntities(Snapshot & snapshot);
+
+    /**
+     * Returns the state of an entity within a snapshot, inserting a blank 
+     * state if the entity is not contained.
+     * 
+     * The entities of the snapshot must be sorted again afterwards.
+     * 
+     * @param snapshot  the snapshot
+     * @param numSorted the number of sorted entities at the front
+     * @param id        the network id of the entity
+     * @return the state of the entity
+     */
+    static EntityState & FindOrAppend(Snapshot & snapshot, size_t numSorted, uint32_t id);
+};
@@ -0,0 +1,150 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <cassert>
+#include "Pose2D.h"
+#include "LinearMovement.h"
+#include "AutoRotate.h"
+#include "CircleCollider.h"
+#include "SoaComponentStore.h"
+
+using namespace astu;
+
+template <typename T>
+static void MoveLastTo(std::vector<T> & v, size_t slot)
+{
+    v[slot] = v.back();
+    v.pop_back();
+}
+
+DenseSlot::DenseSlot(SoaComponentStore & s, size_t idx)
+    : store(&s)
+    , slot(idx)
+{
+    // Intentionally left empty.
+}
+
+DenseSlot::~DenseSlot()
+{
+    if (store) {
+        store->Release(slot);
+    }
+}
+
+SoaComponentStore::SoaComponentStore(size_t _capacity)
+    : BaseService("SoA Component Store")
+    , capacity(_capacity)
+{
+    // Intentionally left empty.
+}
+
+void SoaComponentStore::OnStartup()
+{
+    posX.reserve(capacity);
+    posY.reserve(capacity);
+    angle.reserve(capacity);
+    prevPosX.reserve(capacity);
+    prevPosY.reserve(capacity);
+    prevAngle.reserve(capacity);
+    velX.reserve(capacity);
+    velY.reserve(capacity);
+    rotSpeed.reserve(capacity);
+    radius.reserve(capacity);
+    category.reserve(capacity);
+    mask.reserve(capacity);
+    flags.reserve(capacity);
+    owners.reserve(capacity);
+}
+
+void SoaComponentStore::OnShutdown()
+{
+    // Entities might outlive this store, detach their slots.
+    for (auto owner : owners) {
+        owner->store = nullptr;
+    }
+
+    posX.clear();
+    posY.clear();
+    angle.clear();
+    prevPosX.clear();
+    prevPosY.clear();
+    prevAngle.clear();
+    velX.clear();
+    velY.clear();
+    rotSpeed.clear();
+    radius.clear();
+    category.clear();
+    mask.clear();
+    flags.clear();
+    owners.clear();
+}
+
+std::shared_ptr<DenseSlot> SoaComponentStore::CreateSlot(
+    const Pose2D & pose, 
+    const LinearMovement * mov, 
+    const AutoRotate * rot, 
+    const CircleCollider * col)
+{
+    uint8_t f = 0;
+    f |= mov ? LINEAR_MOVEMENT : 0;
+    f |= rot ? AUTO_ROTATE : 0;
+    f |= col ? CIRCLE_COLLIDER : 0;
+
+    posX.push_back(pose.pos.x);
+    posY.push_back(pose.pos.y);
+    angle.push_back(pose.angle);
+    prevPosX.push_back(pose.prevPos.x);
+    prevPosY.push_back(pose.prevPos.y);
+    prevAngle.push_back(pose.prevAngle);
+    velX.push_back(mov ? mov->vel.x : 0);
+    velY.push_back(mov ? mov->vel.y : 0);
+    rotSpeed.push_back(rot ? rot->speed : 0);
+    radius.push_back(col ? col->radius : 0);
+    category.push_back(col ? col->category : 0);
+    mask.push_back(col ? col->mask : 0);
+    flags.push_back(f);
+
+    auto result = std::make_shared<DenseSlot>(*this, owners.size());
+    owners.push_back(result.get());
+
+    return result;
+}
+
+void SoaComponentStore::SavePreviousPoses()
+{
+    prevPosX = posX;
+    prevPosY = posY;
+    prevAngle = angle;
+}
+
+void SoaComponentStore::Release(size_t slot)
+{
+    assert(slot < owners.size());
+
+    MoveLastTo(posX, slot);
+    MoveLastTo(posY, slot);
+    MoveLastTo(angle, slot);
+    MoveLastTo(prevPosX, slot);
+    MoveLastTo(prevPosY, slot);
+    MoveLastTo(prevAngle, slot);
+    MoveLastTo(velX, slot);
+    MoveLastTo(velY, slot);
+    MoveLastTo(rotSpeed, slot);
+    MoveLastTo(radius, slot);
+    MoveLastTo(category, slot);
+    MoveLastTo(mask, slot);
+    MoveLastTo(flags, slot);
+    MoveLastTo(owners, slot);
+
+    if (slot < owners.size()) {
+        owners[slot]->slot = slot;
+    }
+}
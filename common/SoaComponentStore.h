@@ -0,0 +1,189 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <Service.h>
+#include <EntityService.h>
+
+class Pose2D;
+class LinearMovement;
+class AutoRotate;
+class CircleCollider;
+class SoaComponentStore;
+
+/**
+ * Binds an entity to a slot of the structure-of-arrays component store.
+ * 
+ * Entities carrying this component keep their pose, movement, rotation
+ * and collider data in the store instead of individual components.
+ * The slot is released when the entity gets destroyed.
+ */
+class DenseSlot : public astu::EntityComponent {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param store the store this slot belongs to
+     * @param slot  the index of the slot within the store
+     */
+    DenseSlot(SoaComponentStore & store, size_t slot);
+
+    /**
+     * Virtual destructor, releases the slot.
+     */
+    virtual ~DenseSlot();
+
+    DenseSlot(const DenseSlot &) = delete;
+    DenseSlot & operator=(const DenseSlot &) = delete;
+
+    /**
+     * Returns the index of this slot within the store.
+     * The index changes when other slots get released.
+     * 
+     * @return the index of this slot
+     */
+    size_t GetSlot() const {
+        return slot;
+    }
+
+private:
+    /** The store this slot belongs to, null if the store has shut down. */
+    SoaComponentStore* store;
+
+    /** The index of this slot within the store. */
+    size_t slot;
+
+    friend class SoaComponentStore;
+};
+
+/**
+ * Opt-in dense storage of the hot entity components.
+ * 
+ * Pose2D, LinearMovement, AutoRotate and CircleCollider data is kept in
+ * contiguous arrays indexed by slot, so systems can iterate the arrays
+ * directly instead of looking up components entity by entity. Slots are
+ * kept dense, releasing a slot moves the last slot into the gap.
+ * 
+ * Systems may modify the values of the arrays but must not resize them.
+ */
+class SoaComponentStore : public astu::BaseService {
+public:
+
+    /** Flags describing which optional components a slot holds. */
+    enum ComponentFlags : uint8_t {
+        LINEAR_MOVEMENT = 1,
+        AUTO_ROTATE = 2,
+        CIRCLE_COLLIDER = 4,
+    };
+
+    /** The x-coordinates of the positions. */
+    std::vector<double> posX;
+
+    /** The y-coordinates of the positions. */
+    std::vector<double> posY;
+
+    /** The orientations in radians. */
+    std::vector<double> angle;
+
+    /** The x-coordinates of the positions before the last fixed step. */
+    std::vector<double> prevPosX;
+
+    /** The y-coordinates of the positions before the last fixed step. */
+    std::vector<double> prevPosY;
+
+    /** The orientations before the last fixed step. */
+    std::vector<double> prevAngle;
+
+    /** The x-components of the velocities, zero without linear movement. */
+    std::vector<double> velX;
+
+    /** The y-components of the velocities, zero without linear movement. */
+    std::vector<double> velY;
+
+    /** The rotation speeds in radians per second, zero without auto rotation. */
+    std::vector<double> rotSpeed;
+
+    /** The collider radii, zero without circle collider. */
+    std::vector<double> radius;
+
+    /** The collision categories, zero without circle collider. */
+    std::vector<uint32_t> category;
+
+    /** The collision masks, zero without circle collider. */
+    std::vector<uint32_t> mask;
+
+    /** The component flags of each slot. */
+    std::vector<uint8_t> flags;
+
+    /**
+     * Constructor.
+     * 
+     * @param capacity  the number of slots to reserve memory for
+     */
+    SoaComponentStore(size_t capacity = 0);
+
+    /**
+     * Allocates a new slot and initializes it with the given components.
+     * The returned component must be added to the entity owning the slot.
+     * 
+     * @param pose  the pose of the entity
+     * @param mov   the linear movement of the entity or null
+     * @param rot   the auto rotation of the entity or null
+     * @param col   the circle collider of the entity or null
+     * @return the component binding the slot to an entity
+     */
+    std::shared_ptr<DenseSlot> CreateSlot(
+        const Pose2D & pose, 
+        const LinearMovement * mov = nullptr, 
+        const AutoRotate * rot = nullptr, 
+        const CircleCollider * col = nullptr);
+
+    /**
+     * Saves the current poses of all slots as previous poses. Called 
+     * before the poses get advanced by a fixed simulation step.
+     */
+    void SavePreviousPoses();
+
+    /**
+     * Returns the number of slots currently in use.
+     * 
+     * @return the number of slots
+     */
+    size_t Size() const {
+        return owners.size();
+    }
+
+protected:
+
+    // Inherited via BaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+
+private:
+    /** The number of slots to reserve memory for. */
+    size_t capacity;
+
+    /** The components bound to the slots. */
+    std::vector<DenseSlot*> owners;
+
+    /**
+     * Releases a slot, moving the last slot into the gap.
+     * 
+     * @param slot  the index of the slot to release
+     */
+    void Release(size_t slot);
+
+    friend class DenseSlot;
+};
@@ -0,0 +1,59 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include "SpatialGrid.h"
+
+SpatialGrid::SpatialGrid(double cellSize)
+{
+    Reset(cellSize);
+}
+
+void SpatialGrid::Clear()
+{
+    entries.clear();
+    cells.clear();
+}
+
+void SpatialGrid::Reset(double cellSize)
+{
+    if (cellSize <= 0) {
+        throw std::domain_error("Grid cell size must be greater than zero");
+    }
+    this->cellSize = cellSize;
+    Clear();
+}
+
+void SpatialGrid::Insert(uint32_t idx, double x, double y)
+{
+    const int32_t cx = ToCell(x);
+    const int32_t cy = ToCell(y);
+    entries.push_back({ToCellKey(cx, cy), cx, cy, idx});
+}
+
+void SpatialGrid::Build()
+{
+    std::sort(entries.begin(), entries.end(), 
+        [](const Entry & a, const Entry & b) {
+            return a.key < b.key || (a.key == b.key && a.idx < b.idx);
+        });
+
+    cells.clear();
+    for (size_t i = 0; i < entries.size(); ) {
+        size_t j = i + 1;
+        while (j < entries.size() && entries[j].key == entries[i].key) {
+            ++j;
+        }
+        cells[entries[i].key] = {i, j};
+        i = j;
+    }
+}
@@ -0,0 +1,187 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <unordered_map>
+
+/**
+ * A uniform grid indexing points by their location.
+ * 
+ * The grid is rebuilt from scratch whenever the points have moved: points
+ * are inserted, the grid is built and can be queried afterwards. Memory
+ * is reused from one build to the next.
+ */
+class SpatialGrid {
+public:
+
+    /** Associates a point with the grid cell it is located in. */
+    struct Entry {
+        /** The key of the grid cell. */
+        uint64_t key;
+
+        /** The x-coordinate of the grid cell. */
+        int32_t cx;
+
+        /** The y-coordinate of the grid cell. */
+        int32_t cy;
+
+        /** The index identifying the point. */
+        uint32_t idx;
+    };
+
+    /** A range of points within the sorted entries sharing a grid cell. */
+    struct Cell {
+        /** The index of the first entry. */
+        size_t begin;
+
+        /** The index one past the last entry. */
+        size_t end;
+    };
+
+    /**
+     * Constructor.
+     * 
+     * @param cellSize  the width and height of a grid cell, ideally close
+     *                  to the typical query radius
+     * @throws std::domain_error in case the cell size is not positive
+     */
+    SpatialGrid(double cellSize);
+
+    /**
+     * Removes all points.
+     */
+    void Clear();
+
+    /**
+     * Removes all points and changes the size of the grid cells.
+     * 
+     * @param cellSize  the width and height of a grid cell
+     * @throws std::domain_error in case the cell size is not positive
+     */
+    void Reset(double cellSize);
+
+    /**
+     * Adds a point.
+     * 
+     * @param idx   the index identifying the point
+     * @param x     the x-coordinate of the point
+     * @param y     the y-coordinate of the point
+     */
+    void Insert(uint32_t idx, double x, double y);
+
+    /**
+     * Builds the grid from the inserted points.
+     */
+    void Build();
+
+    /**
+     * Visits all non-empty cells overlapping the bounding box of a circle.
+     * 
+     * @param x         the x-coordinate of the center of the circle
+     * @param y         the y-coordinate of the center of the circle
+     * @param radius    the radius of the circle
+     * @param visitor   called with the coordinates and the range of
+     *                  entries of each visited cell
+     */
+    template <typename F>
+    void QueryCells(double x, double y, double radius, F visitor) const {
+        const int32_t minX = ToCell(x - radius);
+        const int32_t maxX = ToCell(x + radius);
+        const int32_t minY = ToCell(y - radius);
+        const int32_t maxY = ToCell(y + radius);
+
+        for (int32_t cy = minY; cy <= maxY; ++cy) {
+            for (int32_t cx = minX; cx <= maxX; ++cx) {
+                const Cell* cell = FindCell(cx, cy);
+                if (cell) {
+                    visitor(cx, cy, *cell);
+                }
+            }
+        }
+    }
+
+    /**
+     * Returns the width and height of a grid cell.
+     * 
+     * @return the size of a grid cell
+     */
+    double GetCellSize() const {
+        return cellSize;
+    }
+
+    /**
+     * Returns the number of points.
+     * 
+     * @return the number of points
+     */
+    size_t GetNumEntries() const {
+        return entries.size();
+    }
+
+    /**
+     * Returns an entry of the built grid, entries are sorted by grid cell.
+     * 
+     * @param i the index of the entry
+     * @return the requested entry
+     */
+    const Entry & GetEntry(size_t i) const {
+        return entries[i];
+    }
+
+    /**
+     * Looks up a grid cell of the built grid.
+     * 
+     * @param cx    the x-coordinate of the grid cell
+     * @param cy    the y-coordinate of the grid cell
+     * @return the range of entries within the cell or `nullptr` if the
+     *          cell is empty
+     */
+    const Cell* FindCell(int32_t cx, int32_t cy) const {
+        auto it = cells.find(ToCellKey(cx, cy));
+        return it != cells.end() ? &it->second : nullptr;
+    }
+
+private:
+    /** The width and height of a grid cell. */
+    double cellSize;
+
+    /** The points, sorted by grid cell once the grid has been built. */
+    std::vector<Entry> entries;
+
+    /** Maps grid cell keys to ranges within the sorted entries. */
+    std::unordered_map<uint64_t, Cell> cells;
+
+    /**
+     * Returns the grid coordinate of a coordinate in world space.
+     * 
+     * @param v the coordinate in world space
+     * @return the grid coordinate
+     */
+    int32_t ToCell(double v) const {
+        return static_cast<int32_t>(std::floor(v / cellSize));
+    }
+
+    /**
+     * Combines the coordinates of a grid cell into a single key.
+     * 
+     * @param cx    the x-coordinate of the grid cell
+     * @param cy    the y-coordinate of the grid cell
+     * @return the key of the grid cell
+     */
+    static uint64_t ToCellKey(int32_t cx, int32_t cy) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) 
+            | static_cast<uint32_t>(cy);
+    }
+};
@@ -0,0 +1,198 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <stdexcept>
+#include <mutex>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+using socklen_t = int;
+using NativeSocket = SOCKET;
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+using NativeSocket = int;
+#endif
+
+#include "UdpSocket.h"
+
+#ifdef _WIN32
+/** Keeps Winsock initialized while sockets are open. */
+static std::mutex winsockMutex;
+static int winsockUsers = 0;
+
+static void AcquireWinsock()
+{
+    std::lock_guard<std::mutex> lock(winsockMutex);
+    if (winsockUsers++ == 0) {
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+            --winsockUsers;
+            throw std::runtime_error("Unable to initialize Winsock");
+        }
+    }
+}
+
+static void ReleaseWinsock()
+{
+    std::lock_guard<std::mutex> lock(winsockMutex);
+    if (--winsockUsers == 0) {
+        WSACleanup();
+    }
+}
+
+static void CloseSocket(intptr_t handle)
+{
+    closesocket(static_cast<NativeSocket>(handle));
+}
+
+static bool WouldBlock()
+{
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+}
+
+static bool IsTransientError()
+{
+    // Reported for earlier datagrams sent to a closed port.
+    return WSAGetLastError() == WSAECONNRESET;
+}
+
+static const intptr_t kInvalidSocket = static_cast<intptr_t>(INVALID_SOCKET);
+#else
+static void AcquireWinsock()
+{
+    // Intentionally left empty.
+}
+
+static void ReleaseWinsock()
+{
+    // Intentionally left empty.
+}
+
+static void CloseSocket(intptr_t handle)
+{
+    close(static_cast<NativeSocket>(handle));
+}
+
+static bool WouldBlock()
+{
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+static bool IsTransientError()
+{
+    // Interrupted calls and errors reported for earlier datagrams.
+    return errno == EINTR || errno == ECONNREFUSED;
+}
+
+static const intptr_t kInvalidSocket = -1;
+#endif
+
+static sockaddr_in ToSockAddr(const NetAddress & address)
+{
+    sockaddr_in result = {};
+    result.sin_family = AF_INET;
+    result.sin_addr.s_addr = htonl(address.host);
+    result.sin_port = htons(address.port);
+    return result;
+}
+
+NetAddress NetAddress::Parse(const std::string & address, uint16_t port)
+{
+    unsigned int a, b, c, d;
+    char tail;
+    if (std::sscanf(address.c_str(), "%u.%u.%u.%u%c", &a, &b, &c, &d, &tail) != 4
+        || a > 255 || b > 255 || c > 255 || d > 255) 
+    {
+        throw std::domain_error("Invalid IPv4 address '" + address + "'");
+    }
+
+    return NetAddress(a << 24 | b << 16 | c << 8 | d, port);
+}
+
+std::string NetAddress::ToString() const
+{
+    return std::to_string(host >> 24) + "." + std::to_string((host >> 16) & 0xff) + "."
+        + std::to_string((host >> 8) & 0xff) + "." + std::to_string(host & 0xff) 
+        + ":" + std::to_string(port);
+}
+
+UdpSocket::UdpSocket(uint16_t port)
+{
+    AcquireWinsock();
+
+    handle = static_cast<intptr_t>(socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+    if (handle == kInvalidSocket) {
+        ReleaseWinsock();
+        throw std::runtime_error("Unable to open UDP socket");
+    }
+
+    sockaddr_in local = ToSockAddr(NetAddress(INADDR_ANY, port));
+    socklen_t len = sizeof(local);
+    auto native = static_cast<NativeSocket>(handle);
+    bool ok = bind(native, reinterpret_cast<sockaddr*>(&local), len) == 0
+        && getsockname(native, reinterpret_cast<sockaddr*>(&local), &len) == 0;
+
+#ifdef _WIN32
+    u_long nonBlocking = 1;
+    ok = ok && ioctlsocket(native, FIONBIO, &nonBlocking) == 0;
+#else
+    ok = ok && fcntl(native, F_SETFL, O_NONBLOCK) == 0;
+#endif
+
+    if (!ok) {
+        CloseSocket(handle);
+        ReleaseWinsock();
+        throw std::runtime_error("Unable to bind UDP socket to port " + std::to_string(port));
+    }
+    this->port = ntohs(local.sin_port);
+}
+
+UdpSocket::~UdpSocket()
+{
+    CloseSocket(handle);
+    ReleaseWinsock();
+}
+
+bool UdpSocket::Send(const NetAddress & to, const uint8_t* data, size_t size)
+{
+    sockaddr_in remote = ToSockAddr(to);
+    auto result = sendto(static_cast<NativeSocket>(handle), reinterpret_cast<const char*>(data), 
+        static_cast<int>(size), 0, reinterpret_cast<sockaddr*>(&remote), sizeof(remote));
+
+    return result == static_cast<decltype(result)>(size);
+}
+
+size_t UdpSocket::Receive(NetAddress & from, uint8_t* buffer, size_t size)
+{
+    while (true) {
+        sockaddr_in remote = {};
+        socklen_t len = sizeof(remote);
+        auto result = recvfrom(static_cast<NativeSocket>(handle), reinterpret_cast<char*>(buffer), 
+            static_cast<int>(size), 0, reinterpret_cast<sockaddr*>(&remote), &len);
+
+        if (result >= 0) {
+            from = NetAddress(ntohl(remote.sin_addr.s_addr), ntohs(remote.sin_port));
+            return static_cast<size_t>(result);
+        }
+
+        if (WouldBlock() || !IsTransientError()) {
+            return 0;
+        }
+    }
+}
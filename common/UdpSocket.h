@@ -0,0 +1,128 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/**
+ * An IPv4 address and port.
+ */
+struct NetAddress {
+    /** The IPv4 address in host byte order. */
+    uint32_t host;
+
+    /** The port in host byte order. */
+    uint16_t port;
+
+    /**
+     * Constructor.
+     * 
+     * @param h the IPv4 address in host byte order
+     * @param p the port
+     */
+    NetAddress(uint32_t h = 0, uint16_t p = 0)
+        : host(h), port(p)
+    {
+        // Intentionally left empty.
+    }
+
+    /**
+     * Parses an address in dotted decimal notation, e.g., "127.0.0.1".
+     * 
+     * @param address   the textual address
+     * @param port      the port
+     * @return the parsed address
+     * @throws std::domain_error in case the address is malformed
+     */
+    static NetAddress Parse(const std::string & address, uint16_t port);
+
+    /**
+     * Returns this address in dotted decimal notation, including the port.
+     * 
+     * @return the textual representation of this address
+     */
+    std::string ToString() const;
+
+    bool operator==(const NetAddress & o) const {
+        return host == o.host && port == o.port;
+    }
+
+    bool operator!=(const NetAddress & o) const {
+        return !(*this == o);
+    }
+};
+
+/**
+ * A non-blocking UDP socket.
+ * 
+ * Wraps the BSD socket API on POSIX systems and Winsock on Windows.
+ */
+class UdpSocket {
+public:
+
+    /**
+     * Constructor, opens the socket and binds it to a local port.
+     * 
+     * @param port  the local port, zero to choose any free port
+     * @throws std::runtime_error in case the socket can not be opened
+     */
+    UdpSocket(uint16_t port = 0);
+
+    /**
+     * Destructor, closes the socket.
+     */
+    ~UdpSocket();
+
+    UdpSocket(const UdpSocket &) = delete;
+    UdpSocket & operator=(const UdpSocket &) = delete;
+
+    /**
+     * Sends a datagram.
+     * 
+     * Delivery is not guaranteed, a datagram which can not be sent
+     * immediately is dropped, just like datagrams lost on the network.
+     * 
+     * @param to    the receiver of the datagram
+     * @param data  the data to send
+     * @param size  the size of the data in bytes
+     * @return `true` if the datagram has been sent
+     */
+    bool Send(const NetAddress & to, const uint8_t* data, size_t size);
+
+    /**
+     * Receives a pending datagram, without waiting for one.
+     * 
+     * @param from      receives the sender of the datagram
+     * @param buffer    receives the datagram
+     * @param size      the size of the buffer in bytes
+     * @return the size of the received datagram, zero if none is pending
+     */
+    size_t Receive(NetAddress & from, uint8_t* buffer, size_t size);
+
+    /**
+     * Returns the local port this socket is bound to.
+     * 
+     * @return the local port
+     */
+    uint16_t GetPort() const {
+        return port;
+    }
+
+private:
+    /** The native socket handle. */
+    intptr_t handle;
+
+    /** The local port. */
+    uint16_t port;
+};
@@ -14,12 +14,14 @@
 #include <typeindex>
 #include <typeinfo>
 #include <iostream>
+#include <stdexcept>
 #include <AstUtils.h>
 #include <EntityService.h>
 #include "IWindowManager.h"
 #include "Pose2D.h"
 #include "CircleCollider.h"
 #include "LinearMovement.h"
+#include "EntityFactory.h"
 #include "CollisionTestService.h"
 
 #define ENTITY_RADIUS 15.0
@@ -45,9 +47,18 @@ CollisionTestService::CollisionTestService()
 
 void CollisionTestService::OnStartup()
 {
+    // Entities must not be removed while contacts are being reported.
+    destroyQueue = GetSM().FindService<EntityDestroyQueue>();
+    if (!destroyQueue) {
+        throw std::logic_error("Entity destroy queue required for Collision Test Service");
+    }
+
     // Register as collision listener.
-    GetSM().GetService<CollisionEventService>()
-        .AddListener(shared_as<CollisionListener>());
+    GetSM().GetService<CollisionDetectionSystem>()
+        .AddListener(shared_as<ICollisionListener>());
+
+    // Keep test entities in dense store, if available.
+    store = GetSM().FindService<SoaComponentStore>();
 
     auto & wm = GetSM().GetService<IWindowManager>();
 
@@ -63,8 +74,11 @@ void CollisionTestService::OnStartup()
 void CollisionTestService::OnShutdown()
 {
     // De-Register as collision listener.
-    GetSM().GetService<CollisionEventService>()
-        .RemoveListener(shared_as<CollisionListener>());
+    GetSM().GetService<CollisionDetectionSystem>()
+        .RemoveListener(shared_as<ICollisionListener>());
+
+    store = nullptr;
+    destroyQueue = nullptr;
 }
 
 void CollisionTestService::AddTestEntity(const Vector2<double> & p, double s, const Color & c)
@@ -72,22 +86,33 @@ void CollisionTestService::AddTestEntity(const Vector2<double> & p, double s, co
     Vector2<double> v(GetRandomDouble(50, 200), 0);
     v.Rotate(ToRadians(GetRandomDouble(0, 360)));
 
-    auto entity = std::make_shared<Entity>();
-    entity->AddComponent(std::make_shared<Pose2D>(p));
-    entity->AddComponent(std::make_shared<Polyline>(shape, c));
-    entity->AddComponent(std::make_shared<LinearMovement>(v));
-    entity->AddComponent(std::make_shared<CircleCollider>(ENTITY_RADIUS));
+    auto entity = EntityFactory::CreateEntity();
+    entity->AddComponent(EntityFactory::CreateComponent<Polyline>(shape, c));
+    if (store) {
+        LinearMovement mov(v);
+        CircleCollider col(ENTITY_RADIUS);
+        entity->AddComponent(store->CreateSlot(Pose2D(p), &mov, nullptr, &col));
+    } else {
+        entity->AddComponent(EntityFactory::CreateComponent<Pose2D>(p));
+        entity->AddComponent(EntityFactory::CreateComponent<LinearMovement>(v));
+        entity->AddComponent(EntityFactory::CreateComponent<CircleCollider>(ENTITY_RADIUS));
+    }
 
     auto & es = GetSM().GetService<EntityService>();
     es.AddEntity(entity);
 }
 
 
-void CollisionTestService::OnSignal(const CollisionEvent & event)
+void CollisionTestService::OnContactsBegin(const CollisionDetectionSystem & system, const std::vector<Contact> & contacts)
 {
-    if (GetRandomDouble() >= 0.5) {
-        GetSM().GetService<EntityService>().RemoveEntity(event.entityA);
-    } else {
-        GetSM().GetService<EntityService>().RemoveEntity(event.entityB);
+    for (const auto & contact : contacts) {
+        const auto & entityA = system.GetEntityA(contact);
+        const auto & entityB = system.GetEntityB(contact);
+
+        // Entities destroyed by previous contacts of this frame are skipped.
+        if (destroyQueue->IsDead(entityA) || destroyQueue->IsDead(entityB)) {
+            continue;
+        }
+        destroyQueue->Destroy(GetRandomDouble() >= 0.5 ? entityA : entityB);
     }
 }
@@ -15,11 +15,13 @@
 #include <Service.h>
 
 #include "CollisionDetectionSystem.h"
+#include "SoaComponentStore.h"
+#include "EntityDestroyQueue.h"
 #include "Polyline.h"
 
 class CollisionTestService 
     : public astu::BaseService
-    , public CollisionListener
+    , public ICollisionListener
 {
 public:
 
@@ -28,8 +30,8 @@ public:
      */
     CollisionTestService();
 
-    // Inherited via CollisionListener
-    virtual void OnSignal(const CollisionEvent & event) override;       
+    // Inherited via ICollisionListener
+    virtual void OnContactsBegin(const CollisionDetectionSystem & system, const std::vector<Contact> & contacts) override;
 
 protected:
 
@@ -40,6 +42,12 @@ protected:
 private:
     std::shared_ptr<Polyline::Polygon> shape;
 
+    /** The optional dense component store test entities are kept in. */
+    std::shared_ptr<SoaComponentStore> store;
+
+    /** The queue used to destroy entities at the end of the frame. */
+    std::shared_ptr<EntityDestroyQueue> destroyQueue;
+
     /**
      * Adds a test entity at a certain position.
      * 
@@ -19,6 +19,7 @@
 #include "IWindowManager.h"
 #include "Pose2D.h"
 #include "AutoRotate.h"
+#include "EntityFactory.h"
 #include "CreateEntityTestService.h"
 
 #define ENTITY_SIZE 30.0
@@ -67,10 +68,10 @@ void CreateEntityTestService::OnSignal(const MouseButtonEvent & signal)
 
 void CreateEntityTestService::AddTestEntity(int t, const Vector2<double> & p, double s, const Color & c)
 {
-    auto entity = std::make_shared<Entity>();
-    entity->AddComponent(std::make_shared<Pose2D>(p));
-    entity->AddComponent(std::make_shared<Polyline>(t == 1 ? shape1 : shape2, c));
-    entity->AddComponent(std::make_shared<AutoRotate>(ToRadians(s)));
+    auto entity = EntityFactory::CreateEntity();
+    entity->AddComponent(EntityFactory::CreateComponent<Pose2D>(p));
+    entity->AddComponent(EntityFactory::CreateComponent<Polyline>(t == 1 ? shape1 : shape2, c));
+    entity->AddComponent(EntityFactory::CreateComponent<AutoRotate>(ToRadians(s)));
 
     auto & es = GetSM().GetService<EntityService>();
     es.AddEntity(entity);
@@ -17,6 +17,7 @@
 #include "IWindowManager.h"
 #include "Pose2D.h"
 #include "AutoRotate.h"
+#include "PrefabService.h"
 #include "EntityTestService.h"
 
 #define ENTITY_SIZE 30.0
@@ -44,36 +45,42 @@ EntityTestService::EntityTestService()
 
 void EntityTestService::OnStartup()
 {
+    auto & ps = GetSM().GetService<PrefabService>();
+    auto square = std::make_shared<Prefab>("square-spinner");
+    square->Add(Pose2D()).Add(Polyline(shape1)).Add(AutoRotate());
+    ps.AddPrefab(square);
 
-    auto & wm = GetSM().GetService<IWindowManager>();
+    auto triangle = std::make_shared<Prefab>("triangle-spinner");
+    triangle->Add(Pose2D()).Add(Polyline(shape2)).Add(AutoRotate());
+    ps.AddPrefab(triangle);
+
+    size_t numSquares = 0;
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        if (GetRandomInt(1, 3) == 1) {
+            ++numSquares;
+        }
+    }
 
+    auto & wm = GetSM().GetService<IWindowManager>();
     double r = sqrt(ENTITY_SIZE * ENTITY_SIZE * 2);
-    for(int i = 0; i <NUM_ENTITIES; ++i) {
-        Vector2<double> p;
-        p.x = GetRandomDouble(r, wm.GetWidth() - r);
-        p.y = GetRandomDouble(r, wm.GetHeight() - r);
+    auto randomize = [&wm, r](Entity & entity, size_t) {
+        auto & pose = entity.GetComponent<Pose2D>();
+        pose.pos.x = GetRandomDouble(r, wm.GetWidth() - r);
+        pose.pos.y = GetRandomDouble(r, wm.GetHeight() - r);
 
-        Color c;
-        c.r = GetRandomDouble(0.25, 1);
-        c.g = GetRandomDouble(0.25, 1);
-        c.b = GetRandomDouble(0.25, 1);
-        AddTestEntity(GetRandomInt(1, 3), p, GetRandomDouble(-180, 180), c);
-    }
+        auto & poly = entity.GetComponent<Polyline>();
+        poly.color.r = GetRandomDouble(0.25, 1);
+        poly.color.g = GetRandomDouble(0.25, 1);
+        poly.color.b = GetRandomDouble(0.25, 1);
+
+        entity.GetComponent<AutoRotate>().speed = ToRadians(GetRandomDouble(-180, 180));
+    };
+
+    ps.SpawnBatch("square-spinner", numSquares, randomize);
+    ps.SpawnBatch("triangle-spinner", NUM_ENTITIES - numSquares, randomize);
 }
 
 void EntityTestService::OnShutdown()
 {
     // Intentionally left empty.
 }
-
-
-void EntityTestService::AddTestEntity(int t, const Vector2<double> & p, double s, const Color & c)
-{
-    auto entity = std::make_shared<Entity>();
-    entity->AddComponent(std::make_shared<Pose2D>(p));
-    entity->AddComponent(std::make_shared<Polyline>(t == 1 ? shape1 : shape2, c));
-    entity->AddComponent(std::make_shared<AutoRotate>(ToRadians(s)));
-
-    auto & es = GetSM().GetService<EntityService>();
-    es.AddEntity(entity);
-}
@@ -40,6 +40,9 @@ void LineRendererTestService::OnStartup()
         throw std::logic_error("Time service required");
     }
 
+    // Lines are interpolated if they are stepped with a fixed time step.
+    fixedStep = GetSM().FindService<FixedStepService>();
+
     auto & wm = GetSM().GetService<astu::IWindowManager>();
     width = wm.GetWidth();
     height = wm.GetHeight();
@@ -54,6 +57,7 @@ void LineRendererTestService::OnShutdown()
     // Cleanup.
     lineRenderer = nullptr;
     timeService = nullptr;
+    fixedStep = nullptr;
 }
 
 void LineRendererTestService::OnUpdate() 
@@ -70,15 +74,27 @@ void LineRendererTestService::OnUpdate()
         lineRenderer->DrawLine(0, height / 2, width, height / 2);
     }
 
-    // Update moving lines
-    for (auto & line : lines) {
-        UpdateLine(line, timeService->GetElapsedTime());
+    // Update moving lines, unless they are stepped with a fixed time step.
+    double alpha = 1;
+    if (!IsStepped()) {
+        for (auto & line : lines) {
+            UpdateLine(line, timeService->GetElapsedTime());
+        }
+    } else if (fixedStep) {
+        alpha = fixedStep->GetInterpolationFactor();
     }
 
     // Render moving line.
     lineRenderer->SetDrawColor(astu::WebColors::White);
     for (auto & line : lines) {
-        RenderLine(line);
+        RenderLine(line, alpha);
+    }
+}
+
+void LineRendererTestService::OnFixedStep(double dt)
+{
+    for (auto & line : lines) {
+        UpdateLine(line, dt);
     }
 }
 
@@ -92,10 +108,15 @@ LineRendererTestService::MovingLine::MovingLine(double width, double height)
 
     v2.Set(GetRandomDouble(MIN_VEL, MAX_VEL), 0);
     v2.Rotate(GetRandomDouble(0, 2 * M_PI));
+
+    prev1 = p1;
+    prev2 = p2;
 }
 
 void LineRendererTestService::UpdateLine(MovingLine& line, double dt)
 {
+    line.prev1 = line.p1;
+    line.prev2 = line.p2;
     line.p1 += line.v1 * dt;
     line.p2 += line.v2 * dt;
     
@@ -103,9 +124,11 @@ void LineRendererTestService::UpdateLine(MovingLine& line, double dt)
     KeepWithinBoundaries(line.p2, line.v2);
 }
 
-void LineRendererTestService::RenderLine(MovingLine& line)
+void LineRendererTestService::RenderLine(MovingLine& line, double alpha)
 {
-    lineRenderer->DrawLine(line.p1, line.p2);
+    lineRenderer->DrawLine(
+        line.prev1 + (line.p1 - line.prev1) * alpha, 
+        line.prev2 + (line.p2 - line.prev2) * alpha);
 }
 
 void LineRendererTestService::KeepWithinBoundaries(astu::Vector2<double> & p, astu::Vector2<double> & v)
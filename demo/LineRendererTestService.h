@@ -15,9 +15,10 @@
 #include "ITimeService.h"
 #include "ILineRenderer.h"
 #include "UpdateService.h"
+#include "FixedStepService.h"
 
 
-class LineRendererTestService : public astu::UpdatableBaseService {
+class LineRendererTestService : public astu::UpdatableBaseService, public FixedStepSystem {
 public:
 
     /**
@@ -34,6 +35,9 @@ protected:
     virtual void OnShutdown() override;
     virtual void OnUpdate() override;
 
+    // Inherited via FixedStepSystem
+    virtual void OnFixedStep(double dt) override;
+
 private:
     /** Used for fast access to line render service. */
     std::shared_ptr<ILineRenderer> lineRenderer;
@@ -41,6 +45,9 @@ private:
     /** Used for fast access to time service. */
     std::shared_ptr<astu::ITimeService> timeService;
 
+    /** The optional fixed step service, used to interpolate the lines. */
+    std::shared_ptr<FixedStepService> fixedStep;
+
     /** Whether to draw static elements. */
     bool drawStatic;
 
@@ -66,11 +73,17 @@ private:
 
         /** The velocity of the second end point. */
         astu::Vector2<double> v2;
+
+        /** The first point before the last fixed step. */
+        astu::Vector2<double> prev1;
+
+        /** The second point before the last fixed step. */
+        astu::Vector2<double> prev2;
     };
 
     std::vector<MovingLine> lines;
 
     void UpdateLine(MovingLine& line, double dt);
-    void RenderLine(MovingLine& line);
+    void RenderLine(MovingLine& line, double alpha);
     void KeepWithinBoundaries(astu::Vector2<double> & p, astu::Vector2<double> & v);
 }; 
\ No newline at end of file
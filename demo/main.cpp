@@ -35,12 +35,21 @@
 #include "WindowTitleService.h"
 #include "CollisionDetectionSystem.h"
 #include "CollisionTestService.h"
+#include "SoaComponentStore.h"
+#include "LinearMovementSystem.h"
+#include "JobSystem.h"
+#include "ParallelSystemGroup.h"
+#include "FrameProfiler.h"
+#include "ProfilerOverlay.h"
+#include "PrefabService.h"
+#include "EntityDestroyQueue.h"
+#include "FixedStepService.h"
+#include "FramePipeline.h"
 
 // Applications specific
 #include "LineRendererTestService.h"
 #include "EntityTestService.h"
 #include "CreateEntityTestService.h"
-#include "LinearMovementSystem.h"
 
 using namespace std;
 using namespace astu;
@@ -48,6 +57,12 @@ using namespace astu;
 const std::string kAppName = "Bagaga Demo";
 const std::string kAppVersion = "0.4.0";
 
+/** 
+ * The length of a simulation step in seconds. The simulation runs at a 
+ * fixed rate independent of the frame rate, rendering interpolates.
+ */
+const double kSimulationStep = 1.0 / 30.0;
+
 class MyButtonHandler : public astu::MouseButtonListener {
 public:
 
@@ -115,6 +130,10 @@ void AddCoreServices()
 	// Add basic functionality.
 	sm.AddService(std::make_shared<UpdateService>());
 	sm.AddService(std::make_shared<StateService>());
+	sm.AddService(std::make_shared<JobSystem>());
+#ifdef BAGAGA_PROFILER
+	sm.AddService(std::make_shared<FrameProfiler>("bagaga_trace.json"));
+#endif
 
 	// Add services requried for SDL-based core functionality
 	sm.AddService(std::make_shared<SdlService>(true));
@@ -137,15 +156,32 @@ void AddApplicationStates()
 	ss.CreateState("MovingLines"); // optional
 	ss.AddService("MovingLines", std::make_shared<WindowTitleService>("(MovingLines)"));
 	ss.AddService("MovingLines", std::make_shared<SdlLineRenderer>());
-	ss.AddService("MovingLines", std::make_shared<LineRendererTestService>());
+	auto movingLines = std::make_shared<LineRendererTestService>();
+	auto movingLinesStep = std::make_shared<FixedStepService>(kSimulationStep);
+	movingLinesStep->AddSystem(movingLines);
+	auto movingLinesPipeline = std::make_shared<FramePipeline>();
+	movingLinesPipeline->AddSystem(movingLinesStep);
+	ss.AddService("MovingLines", movingLinesStep);
+	ss.AddService("MovingLines", movingLines);
+	ss.AddService("MovingLines", movingLinesPipeline);
 
 	// Add entity demo state.
 	ss.CreateState("Entities"); // optional
 	ss.AddService("Entities", std::make_shared<WindowTitleService>("(Entities)"));
 	ss.AddService("Entities", std::make_shared<EntityService>());
+	ss.AddService("Entities", std::make_shared<PrefabService>());
 	ss.AddService("Entities", std::make_shared<SdlLineRenderer>());
-	ss.AddService("Entities", std::make_shared<AutoRotateSystem>());
-	ss.AddService("Entities", std::make_shared<PolylineVisualSystem>());
+	auto entitiesRotate = std::make_shared<AutoRotateSystem>();
+	auto entitiesStep = std::make_shared<FixedStepService>(kSimulationStep);
+	entitiesStep->AddSystem(entitiesRotate);
+	auto entitiesVisuals = std::make_shared<PolylineVisualSystem>();
+	auto entitiesPipeline = std::make_shared<FramePipeline>();
+	entitiesPipeline->AddSystem(entitiesStep);
+	entitiesPipeline->AddSystem(entitiesVisuals);
+	ss.AddService("Entities", entitiesRotate);
+	ss.AddService("Entities", entitiesStep);
+	ss.AddService("Entities", entitiesVisuals);
+	ss.AddService("Entities", entitiesPipeline);
 	ss.AddService("Entities", std::make_shared<EntityTestService>());
 
 	// Add create entities test state.
@@ -153,21 +189,52 @@ void AddApplicationStates()
 	ss.AddService("Create Entities", std::make_shared<WindowTitleService>("(Create Entities)"));
 	ss.AddService("Create Entities", std::make_shared<EntityService>());
 	ss.AddService("Create Entities", std::make_shared<SdlLineRenderer>());
-	ss.AddService("Create Entities", std::make_shared<AutoRotateSystem>());
-	ss.AddService("Create Entities", std::make_shared<PolylineVisualSystem>());
+	auto createRotate = std::make_shared<AutoRotateSystem>();
+	auto createStep = std::make_shared<FixedStepService>(kSimulationStep);
+	createStep->AddSystem(createRotate);
+	auto createVisuals = std::make_shared<PolylineVisualSystem>();
+	auto createPipeline = std::make_shared<FramePipeline>();
+	createPipeline->AddSystem(createStep);
+	createPipeline->AddSystem(createVisuals);
+	ss.AddService("Create Entities", createRotate);
+	ss.AddService("Create Entities", createStep);
+	ss.AddService("Create Entities", createVisuals);
+	ss.AddService("Create Entities", createPipeline);
 	ss.AddService("Create Entities", std::make_shared<CreateEntityTestService>());
 
 	// Add collision test state.
 	ss.CreateState("Collision Test");	// optional
 	ss.AddService("Collision Test", std::make_shared<WindowTitleService>("(Collision Test)"));
 	ss.AddService("Collision Test", std::make_shared<EntityService>());
+	ss.AddService("Collision Test", std::make_shared<SoaComponentStore>());
 	ss.AddService("Collision Test", std::make_shared<SdlLineRenderer>());
-	ss.AddService("Collision Test", std::make_shared<AutoRotateSystem>());
-	ss.AddService("Collision Test", std::make_shared<PolylineVisualSystem>());
-	ss.AddService("Collision Test", std::make_shared<LinearMovementSystem>());	
-	ss.AddService("Collision Test", std::make_shared<CollisionEventService>());
-	ss.AddService("Collision Test", std::make_shared<CollisionDetectionSystem>());	
+	auto autoRotate = std::make_shared<AutoRotateSystem>();
+	auto linearMovement = std::make_shared<LinearMovementSystem>();
+	auto simulation = std::make_shared<ParallelSystemGroup>();
+	simulation->AddSystem(autoRotate);
+	simulation->AddSystem(linearMovement);
+	auto collisionDetection = std::make_shared<CollisionDetectionSystem>();
+	auto destroyQueue = std::make_shared<EntityDestroyQueue>();
+	auto fixedStep = std::make_shared<FixedStepService>(kSimulationStep);
+	fixedStep->AddSystem(simulation);
+	fixedStep->AddSystem(collisionDetection);
+	fixedStep->AddSystem(destroyQueue);
+	auto visuals = std::make_shared<PolylineVisualSystem>();
+	auto pipeline = std::make_shared<FramePipeline>();
+	pipeline->AddSystem(fixedStep);
+	pipeline->AddSystem(visuals);
+	ss.AddService("Collision Test", autoRotate);
+	ss.AddService("Collision Test", linearMovement);	
+	ss.AddService("Collision Test", simulation);
+	ss.AddService("Collision Test", collisionDetection);	
+	ss.AddService("Collision Test", destroyQueue);
 	ss.AddService("Collision Test", std::make_shared<CollisionTestService>());
+	ss.AddService("Collision Test", fixedStep);
+	ss.AddService("Collision Test", visuals);
+	ss.AddService("Collision Test", pipeline);
+#ifdef BAGAGA_PROFILER
+	ss.AddService("Collision Test", std::make_shared<ProfilerOverlay>());
+#endif
 }
 
 
@@ -202,6 +269,13 @@ int main()
 	while (!event.IsQuit())
 	{
 		updater.UpdateAll();
+
+		// The next frame is simulated while the current one is presented,
+		// it must be done before the services are updated again.
+		auto pipeline = sm.FindService<FramePipeline>();
+		if (pipeline) {
+			pipeline->Sync();
+		}
 	}
 
 	// Game loop has ended, shutdown services.
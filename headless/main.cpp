@@ -0,0 +1,170 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+// Standard C++ Libryry
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+
+// AST Utilities
+#include <AstUtils.h>
+#include <ServiceManager.h>
+#include <UpdateService.h>
+#include <StateService.h>
+#include <EntityService.h>
+
+// Bagaga Commons
+#include "NullLineRenderer.h"
+#include "FixedTimeService.h"
+#include "HeadlessWindowManager.h"
+#include "PolylineVisualSystem.h"
+#include "AutoRotateSystem.h"
+#include "CollisionDetectionSystem.h"
+#include "SoaComponentStore.h"
+#include "LinearMovementSystem.h"
+#include "JobSystem.h"
+#include "ParallelSystemGroup.h"
+#include "FrameProfiler.h"
+#include "PrefabService.h"
+#include "EntityDestroyQueue.h"
+
+// Demo services used as workload
+#include "EntityTestService.h"
+#include "CollisionTestService.h"
+
+using namespace std;
+using namespace astu;
+
+const std::string kAppName = "Bagaga Headless";
+const std::string kAppVersion = "0.1.0";
+
+/** The number of frames to run each state, unless specified otherwise. */
+const int kDefaultNumFrames = 1000;
+
+/**
+ * Adds services required for all application states.
+ */
+void AddCoreServices()
+{
+	// Fetch service manager (realized as a singleton)
+	auto &sm = ServiceManager::GetInstance();
+
+	// Add basic functionality.
+	sm.AddService(std::make_shared<UpdateService>());
+	sm.AddService(std::make_shared<StateService>());
+	sm.AddService(std::make_shared<JobSystem>());
+#ifdef BAGAGA_PROFILER
+	sm.AddService(std::make_shared<FrameProfiler>("bagaga_headless_trace.json"));
+#endif
+
+	// Replacements for the SDL-based services, no window required.
+	sm.AddService(std::make_shared<HeadlessWindowManager>());
+	sm.AddService(std::make_shared<FixedTimeService>());
+}
+
+/**
+ * Adds the application states used as workload.
+ * 
+ * @param renderer	the line renderer used by all states
+ */
+void AddApplicationStates(std::shared_ptr<NullLineRenderer> renderer)
+{
+	// Fetch central state service.
+	auto & ss = ServiceManager::GetInstance().GetService<StateService>();
+
+	// Add entity demo state.
+	ss.CreateState("Entities");
+	ss.AddService("Entities", std::make_shared<EntityService>());
+	ss.AddService("Entities", std::make_shared<PrefabService>());
+	ss.AddService("Entities", renderer);
+	ss.AddService("Entities", std::make_shared<AutoRotateSystem>());
+	ss.AddService("Entities", std::make_shared<PolylineVisualSystem>());
+	ss.AddService("Entities", std::make_shared<EntityTestService>());
+
+	// Add collision test state.
+	ss.CreateState("Collision Test");
+	ss.AddService("Collision Test", std::make_shared<EntityService>());
+	ss.AddService("Collision Test", std::make_shared<SoaComponentStore>());
+	ss.AddService("Collision Test", renderer);
+	auto autoRotate = std::make_shared<AutoRotateSystem>();
+	auto linearMovement = std::make_shared<LinearMovementSystem>();
+	auto simulation = std::make_shared<ParallelSystemGroup>();
+	simulation->AddSystem(autoRotate);
+	simulation->AddSystem(linearMovement);
+	ss.AddService("Collision Test", autoRotate);
+	ss.AddService("Collision Test", linearMovement);
+	ss.AddService("Collision Test", simulation);
+	ss.AddService("Collision Test", std::make_shared<PolylineVisualSystem>());
+	ss.AddService("Collision Test", std::make_shared<CollisionDetectionSystem>());
+	ss.AddService("Collision Test", std::make_shared<CollisionTestService>());
+	ss.AddService("Collision Test", std::make_shared<EntityDestroyQueue>());
+}
+
+/**
+ * Runs an application state for a number of frames and reports the throughput.
+ * 
+ * @param state		the name of the state to run
+ * @param numFrames	the number of frames to run
+ * @param renderer	the line renderer used by the state
+ */
+void RunState(const std::string & state, int numFrames, const NullLineRenderer & renderer)
+{
+	auto &sm = ServiceManager::GetInstance();
+	sm.GetService<StateService>().SwitchState(state);
+
+	auto &updater = sm.GetService<UpdateService>();
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < numFrames; ++i) {
+		updater.UpdateAll();
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	double seconds = elapsed.count();
+	std::cout << state << ": " << numFrames << " frames in " << seconds << " s, "
+		<< (seconds > 0 ? numFrames / seconds : 0) << " frames/s, "
+		<< 1000.0 * seconds / numFrames << " ms/frame, "
+		<< static_cast<double>(renderer.GetNumLines()) / numFrames << " lines/frame"
+		<< std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	SayVersion();
+
+	int numFrames = argc > 1 ? std::atoi(argv[1]) : kDefaultNumFrames;
+	if (numFrames <= 0) {
+		std::cerr << "usage: " << argv[0] << " [number of frames]" << std::endl;
+		return -1;
+	}
+
+	auto renderer = std::make_shared<NullLineRenderer>();
+	AddCoreServices();
+	AddApplicationStates(renderer);
+
+	// Fetch service manager (realized as a singleton)
+	auto &sm = ServiceManager::GetInstance();
+
+	// configure application
+	sm.GetService<IWindowManager>().SetTitle(kAppName + " - Version " + kAppVersion);
+	sm.GetService<IWindowManager>().SetSize(640, 480);
+
+	// Start services
+	sm.StartupAll();
+
+	RunState("Entities", numFrames, *renderer);
+	RunState("Collision Test", numFrames, *renderer);
+
+	// Shutdown services.
+	sm.ShutdownAll();
+
+	return 0;
+}
@@ -0,0 +1,121 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <stdexcept>
+#include <AstUtils.h>
+#include <IWindowManager.h>
+#include "Pose2D.h"
+#include "LinearMovement.h"
+#include "AutoRotate.h"
+#include "CircleCollider.h"
+#include "EntityFactory.h"
+#include "Replicated.h"
+#include "ShapeCatalog.h"
+#include "MatchService.h"
+
+#define MIN_RADIUS 5.0
+#define MAX_RADIUS 15.0
+#define MIN_SPEED 50.0
+#define MAX_SPEED 200.0
+#define MAX_ROTATION_SPEED 180.0
+
+using namespace astu;
+
+MatchService::MatchService(size_t numEntities)
+    : BaseService("Match")
+    , numEntities(numEntities)
+    , nextId(1)
+{
+    // Intentionally left empty.
+}
+
+void MatchService::OnStartup()
+{
+    store = GetSM().FindService<SoaComponentStore>();
+    if (!store) {
+        throw std::logic_error("Match service requires a dense component store");
+    }
+
+    // Register as collision listener.
+    GetSM().GetService<CollisionDetectionSystem>()
+        .AddListener(shared_as<ICollisionListener>());
+
+    auto & wm = GetSM().GetService<IWindowManager>();
+    for (size_t i = 0; i < numEntities; ++i) {
+        SpawnEntity(wm.GetWidth(), wm.GetHeight());
+    }
+}
+
+void MatchService::OnShutdown()
+{
+    // De-Register as collision listener.
+    GetSM().GetService<CollisionDetectionSystem>()
+        .RemoveListener(shared_as<ICollisionListener>());
+
+    store = nullptr;
+}
+
+void MatchService::SpawnEntity(double width, double height)
+{
+    // Radii are whole numbers, so clients can use circle shapes of the catalog.
+    const uint16_t shape = ShapeCatalog::GetCircleId(GetRandomDouble(MIN_RADIUS, MAX_RADIUS));
+    const double radius = shape;
+    Vector2<double> p(
+        GetRandomDouble(radius, width - radius), 
+        GetRandomDouble(radius, height - radius));
+
+    Vector2<double> v(GetRandomDouble(MIN_SPEED, MAX_SPEED), 0);
+    v.Rotate(ToRadians(GetRandomDouble(0, 360)));
+
+    LinearMovement mov(v);
+    AutoRotate rot(ToRadians(GetRandomDouble(-MAX_ROTATION_SPEED, MAX_ROTATION_SPEED)));
+    CircleCollider col(radius);
+
+    Color c;
+    c.r = GetRandomDouble(0.25, 1);
+    c.g = GetRandomDouble(0.25, 1);
+    c.b = GetRandomDouble(0.25, 1);
+
+    auto entity = EntityFactory::CreateEntity();
+    entity->AddComponent(store->CreateSlot(Pose2D(p), &mov, &rot, &col));
+    entity->AddComponent(EntityFactory::CreateComponent<Replicated>(nextId++, shape, c));
+    GetSM().GetService<EntityService>().AddEntity(entity);
+}
+
+size_t MatchService::GetSlot(const std::shared_ptr<Entity> & entity)
+{
+    return entity->GetComponent<DenseSlot>().GetSlot();
+}
+
+void MatchService::OnContactsBegin(const CollisionDetectionSystem & system, const std::vector<Contact> & contacts)
+{
+    auto & velX = store->velX;
+    auto & velY = store->velY;
+
+    for (const auto & contact : contacts) {
+        const size_t a = GetSlot(system.GetEntityA(contact));
+        const size_t b = GetSlot(system.GetEntityB(contact));
+
+        // Exchange the velocity components along the contact normal,
+        // unless the entities already move apart.
+        const double relVel = (velX[b] - velX[a]) * contact.normal.x 
+            + (velY[b] - velY[a]) * contact.normal.y;
+
+        if (relVel >= 0) {
+            continue;
+        }
+
+        velX[a] += relVel * contact.normal.x;
+        velY[a] += relVel * contact.normal.y;
+        velX[b] -= relVel * contact.normal.x;
+        velY[b] -= relVel * contact.normal.y;
+    }
+}
@@ -0,0 +1,76 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <memory>
+#include <Service.h>
+#include <EntityService.h>
+
+#include "CollisionDetectionSystem.h"
+#include "SoaComponentStore.h"
+
+/**
+ * Populates and runs the world of a single match on the server.
+ * 
+ * The match consists of moving and rotating circles which bounce off each
+ * other and are replicated to the clients. All entities are kept in the dense component store, hence the
+ * simulation runs without per-entity component lookups and without
+ * allocating memory once the match has started.
+ */
+class MatchService 
+    : public astu::BaseService
+    , public ICollisionListener
+{
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param numEntities   the number of entities to spawn
+     */
+    MatchService(size_t numEntities = 200);
+
+    // Inherited via ICollisionListener
+    virtual void OnContactsBegin(const CollisionDetectionSystem & system, const std::vector<Contact> & contacts) override;
+
+protected:
+
+    // Inherited via BaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+
+private:
+    /** The number of entities to spawn. */
+    size_t numEntities;
+
+    /** The network id of the next spawned entity. */
+    uint32_t nextId;
+
+    /** The dense component store holding the entities of the match. */
+    std::shared_ptr<SoaComponentStore> store;
+
+    /**
+     * Spawns an entity at a random location within the world boundaries.
+     * 
+     * @param width     the width of the world
+     * @param height    the height of the world
+     */
+    void SpawnEntity(double width, double height);
+
+    /**
+     * Returns the dense store slot of an entity.
+     * 
+     * @param entity    the entity
+     * @return the slot of the entity
+     */
+    static size_t GetSlot(const std::shared_ptr<astu::Entity> & entity);
+};
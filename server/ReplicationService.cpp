@@ -0,0 +1,437 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <iostream>
+#include <IWindowManager.h>
+#include "Pose2D.h"
+#include "LinearMovement.h"
+#include "Replicated.h"
+#include "NetProtocol.h"
+#include "ShapeCatalog.h"
+#include "FrameProfiler.h"
+#include "ReplicationService.h"
+
+#define MAX_CLIENTS 32
+#define HISTORY_SIZE 32
+#define INPUT_BUFFER_SIZE 64
+#define CLIENT_TIMEOUT std::chrono::seconds(5)
+#define PLAYER_ID_BASE 0x40000000
+#define PLAYER_RADIUS 12.0
+#define VIEW_RADIUS 400.0
+#define VIEW_MARGIN 50.0
+#define VIEW_GRID_CELLS 8
+
+using namespace astu;
+
+ReplicationService::ReplicationService(uint16_t port, int tickRate, int snapshotRate, int priority)
+    : UpdatableBaseService("Replication", priority)
+    , port(port)
+    , tickRate(tickRate)
+    , sendInterval(std::max(1, tickRate / std::max(1, snapshotRate)))
+    , tick(0)
+    , nextPlayerId(PLAYER_ID_BASE)
+    , updateCounter(0)
+    , sequence(SnapshotCodec::NO_BASELINE)
+    , numBytesSent(0)
+    , enterRadius(VIEW_RADIUS)
+    , leaveRadius(VIEW_RADIUS + VIEW_MARGIN)
+    , grid((VIEW_RADIUS + VIEW_MARGIN) / VIEW_GRID_CELLS)
+    , packet(NetProtocol::MAX_PACKET_SIZE)
+    , receiveBuffer(NetProtocol::MAX_PACKET_SIZE)
+{
+    if (tickRate <= 0) {
+        throw std::domain_error("Tick rate must be greater than zero");
+    }
+}
+
+void ReplicationService::SetViewRadius(double radius, double margin)
+{
+    if (radius <= 0 || margin < 0) {
+        throw std::domain_error("Invalid view radius or margin");
+    }
+    enterRadius = radius;
+    leaveRadius = radius + margin;
+    grid.Reset(leaveRadius / VIEW_GRID_CELLS);
+}
+
+void ReplicationService::OnStartup()
+{
+    auto & es = GetSM().GetService<EntityService>();
+    entityView = es.GetEntityView(EntityFamily::Create<Replicated, Pose2D>());
+    movingView = es.GetEntityView(EntityFamily::Create<Replicated, Pose2D, LinearMovement>());
+
+    store = GetSM().FindService<SoaComponentStore>();
+    if (store) {
+        denseView = es.GetEntityView(EntityFamily::Create<Replicated, DenseSlot>());
+    }
+
+    socket = std::make_unique<UdpSocket>(port);
+    std::cout << "listening on UDP port " << socket->GetPort() << std::endl;
+}
+
+void ReplicationService::OnShutdown()
+{
+    socket = nullptr;
+    while (!clients.empty()) {
+        RemoveClient(clients.size() - 1);
+    }
+    current.entities.clear();
+    entityView = nullptr;
+    movingView = nullptr;
+    denseView = nullptr;
+    store = nullptr;
+}
+
+void ReplicationService::OnUpdate()
+{
+    BAGAGA_PROFILE_SCOPE("Replication");
+
+    ++tick;
+    ReceiveMessages();
+    DropIdleClients();
+    ApplyInputs();
+
+    if (++updateCounter < sendInterval) {
+        return;
+    }
+    updateCounter = 0;
+
+    CaptureSnapshot();
+
+    grid.Clear();
+    for (size_t i = 0; i < current.entities.size(); ++i) {
+        const auto & state = current.entities[i];
+        grid.Insert(static_cast<uint32_t>(i), 
+            SnapshotCodec::DequantizePosition(state.x), SnapshotCodec::DequantizePosition(state.y));
+    }
+    grid.Build();
+
+    for (auto & client : clients) {
+        UpdateView(client);
+        SendSnapshot(client);
+    }
+}
+
+void ReplicationService::ReceiveMessages()
+{
+    NetAddress from;
+    size_t size;
+    while ((size = socket->Receive(from, receiveBuffer.data(), receiveBuffer.size())) > 0) {
+        InputBuffer in(receiveBuffer.data(), size);
+        MessageType type;
+        if (!NetProtocol::ReadHeader(in, type)) {
+            continue;
+        }
+
+        Client* client = FindClient(from);
+        switch (type) {
+        case MessageType::HELLO:
+            if (!client) {
+                if (clients.size() >= MAX_CLIENTS) {
+                    break;
+                }
+                client = &AddClient(from);
+            }
+
+            // The client has no snapshot yet, send full state.
+            client->ackedSequence = SnapshotCodec::NO_BASELINE;
+            client->cursor = 0;
+            client->lastHeard = Clock::now();
+            break;
+
+        case MessageType::ACK:
+            if (client) {
+                uint32_t acked = in.ReadUInt32();
+                if (in.IsValid() && acked > client->ackedSequence && acked <= sequence) {
+                    client->ackedSequence = acked;
+                }
+                client->lastHeard = Clock::now();
+            }
+            break;
+
+        case MessageType::INPUT:
+            if (client) {
+                ReceiveInputs(*client, in);
+                client->lastHeard = Clock::now();
+            }
+            break;
+
+        case MessageType::BYE:
+            if (client) {
+                std::cout << "client " << from.ToString() << " left" << std::endl;
+                RemoveClient(client - clients.data());
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+}
+
+ReplicationService::Client & ReplicationService::AddClient(const NetAddress & address)
+{
+    std::cout << "client " << address.ToString() << " joined" << std::endl;
+
+    clients.push_back(Client());
+    auto & client = clients.back();
+    client.address = address;
+    client.history.resize(HISTORY_SIZE);
+    client.inputs.resize(INPUT_BUFFER_SIZE);
+    client.receivedInput = 0;
+    client.lastInput = 0;
+
+    // Players enter the world in its center.
+    auto & wm = GetSM().GetService<IWindowManager>();
+    Pose2D pose(wm.GetWidth() / 2.0, wm.GetHeight() / 2.0);
+    client.player = std::make_shared<Entity>();
+    client.player->AddComponent(std::make_shared<Pose2D>(pose));
+    client.player->AddComponent(std::make_shared<Replicated>(
+        nextPlayerId++, ShapeCatalog::GetCircleId(PLAYER_RADIUS), WebColors::White));
+    GetSM().GetService<EntityService>().AddEntity(client.player);
+
+    return client;
+}
+
+void ReplicationService::RemoveClient(size_t idx)
+{
+    GetSM().GetService<EntityService>().RemoveEntity(clients[idx].player);
+    clients.erase(clients.begin() + idx);
+}
+
+void ReplicationService::ReceiveInputs(Client & client, InputBuffer & in)
+{
+    const uint32_t first = in.ReadUInt32();
+    const uint8_t count = in.ReadUInt8();
+    if (!in.IsValid() || first == 0 || count > NetProtocol::MAX_INPUTS_PER_MESSAGE) {
+        return;
+    }
+
+    for (uint32_t seq = first; seq < first + count; ++seq) {
+        PlayerInput input;
+        input.targetX = in.ReadVarInt();
+        input.targetY = in.ReadVarInt();
+        if (!in.IsValid() || seq <= client.receivedInput) {
+            continue;
+        }
+
+        // Inputs lost in transit are replaced by the next known input.
+        uint32_t gap = std::max(client.receivedInput + 1, seq - std::min<uint32_t>(seq, INPUT_BUFFER_SIZE - 1));
+        for (; gap <= seq; ++gap) {
+            client.inputs[gap % INPUT_BUFFER_SIZE] = input;
+        }
+        client.receivedInput = seq;
+    }
+
+    // Clients far ahead of the server skip their oldest inputs.
+    if (client.receivedInput - client.lastInput > INPUT_BUFFER_SIZE) {
+        client.lastInput = client.receivedInput - INPUT_BUFFER_SIZE;
+    }
+}
+
+void ReplicationService::ApplyInputs()
+{
+    const double dt = 1.0 / tickRate;
+    for (auto & client : clients) {
+        if (client.lastInput < client.receivedInput) {
+            ++client.lastInput;
+            PlayerMovement::Step(client.player->GetComponent<Pose2D>(), 
+                client.inputs[client.lastInput % INPUT_BUFFER_SIZE], dt);
+        }
+    }
+}
+
+ReplicationService::Client* ReplicationService::FindClient(const NetAddress & address)
+{
+    for (auto & client : clients) {
+        if (client.address == address) {
+            return &client;
+        }
+    }
+    return nullptr;
+}
+
+void ReplicationService::DropIdleClients()
+{
+    const auto now = Clock::now();
+    for (size_t i = clients.size(); i-- > 0; ) {
+        if (now - clients[i].lastHeard > CLIENT_TIMEOUT) {
+            std::cout << "client " << clients[i].address.ToString() << " timed out" << std::endl;
+            RemoveClient(i);
+        }
+    }
+}
+
+void ReplicationService::CaptureSnapshot()
+{
+    current.sequence = ++sequence;
+    current.tick = tick;
+    current.entities.clear();
+
+    for (size_t i = 0; i < entityView->size(); ++i) {
+        auto & entity = *(*entityView)[i];
+        const auto & rep = entity.GetComponent<Replicated>();
+        const auto & pose = entity.GetComponent<Pose2D>();
+
+        EntityState state = {};
+        state.id = rep.id;
+        state.x = SnapshotCodec::QuantizePosition(pose.pos.x);
+        state.y = SnapshotCodec::QuantizePosition(pose.pos.y);
+        state.angle = SnapshotCodec::QuantizeAngle(pose.angle);
+        state.shape = rep.shape;
+        state.color = SnapshotCodec::QuantizeColor(rep.color);
+        current.entities.push_back(state);
+    }
+
+    if (denseView) {
+        for (size_t i = 0; i < denseView->size(); ++i) {
+            auto & entity = *(*denseView)[i];
+            const auto & rep = entity.GetComponent<Replicated>();
+            const size_t slot = entity.GetComponent<DenseSlot>().GetSlot();
+
+            EntityState state = {};
+            state.id = rep.id;
+            state.x = SnapshotCodec::QuantizePosition(store->posX[slot]);
+            state.y = SnapshotCodec::QuantizePosition(store->posY[slot]);
+            state.angle = SnapshotCodec::QuantizeAngle(store->angle[slot]);
+            state.vx = SnapshotCodec::QuantizePosition(store->velX[slot]);
+            state.vy = SnapshotCodec::QuantizePosition(store->velY[slot]);
+            state.shape = rep.shape;
+            state.color = SnapshotCodec::QuantizeColor(rep.color);
+            current.entities.push_back(state);
+        }
+    }
+
+    auto byId = [](const EntityState & a, const EntityState & b) {
+        return a.id < b.id;
+    };
+    std::sort(current.entities.begin(), current.entities.end(), byId);
+
+    // Velocities of entities which are not kept in the dense store.
+    for (size_t i = 0; i < movingView->size(); ++i) {
+        auto & entity = *(*movingView)[i];
+        EntityState key = {};
+        key.id = entity.GetComponent<Replicated>().id;
+        auto it = std::lower_bound(current.entities.begin(), current.entities.end(), key, byId);
+        if (it != current.entities.end() && it->id == key.id) {
+            const auto & vel = entity.GetComponent<LinearMovement>().vel;
+            it->vx = SnapshotCodec::QuantizePosition(vel.x);
+            it->vy = SnapshotCodec::QuantizePosition(vel.y);
+        }
+    }
+}
+
+void ReplicationService::UpdateView(Client & client)
+{
+    const auto & center = client.player->GetComponent<Pose2D>().pos;
+    const double enter2 = enterRadius * enterRadius;
+    const double leave2 = leaveRadius * leaveRadius;
+    const double cellSize = grid.GetCellSize();
+
+    // Only entities in grid cells close to the client are considered, all
+    // others are beyond the leave radius and drop out of the view. Cells 
+    // entirely within the enter radius are taken as a whole, only entities
+    // in cells crossing the view ring are tested one by one.
+    candidates.clear();
+    grid.QueryCells(center.x, center.y, leaveRadius, 
+        [&](int32_t cx, int32_t cy, const SpatialGrid::Cell & cell) 
+    {
+        const double x0 = cx * cellSize - center.x;
+        const double y0 = cy * cellSize - center.y;
+        const double x1 = x0 + cellSize;
+        const double y1 = y0 + cellSize;
+        const double nearX = x0 > 0 ? x0 : (x1 < 0 ? x1 : 0);
+        const double nearY = y0 > 0 ? y0 : (y1 < 0 ? y1 : 0);
+        if (nearX * nearX + nearY * nearY > leave2) {
+            return;
+        }
+
+        const double farX = std::max(x0 * x0, x1 * x1);
+        const double farY = std::max(y0 * y0, y1 * y1);
+        if (farX + farY <= enter2) {
+            for (size_t i = cell.begin; i < cell.end; ++i) {
+                const uint32_t idx = grid.GetEntry(i).idx;
+                candidates.push_back(std::make_pair(current.entities[idx].id, idx));
+            }
+            return;
+        }
+
+        for (size_t i = cell.begin; i < cell.end; ++i) {
+            const uint32_t idx = grid.GetEntry(i).idx;
+            const auto & state = current.entities[idx];
+            Vector2<double> d(
+                SnapshotCodec::DequantizePosition(state.x) - center.x, 
+                SnapshotCodec::DequantizePosition(state.y) - center.y);
+
+            const double dist2 = d.LengthSquared();
+            if (dist2 <= enter2 || (dist2 <= leave2 
+                && std::binary_search(client.relevant.begin(), client.relevant.end(), state.id))) 
+            {
+                candidates.push_back(std::make_pair(state.id, idx));
+            }
+        }
+    });
+    std::sort(candidates.begin(), candidates.end());
+
+    client.relevant.clear();
+    view.sequence = current.sequence;
+    view.tick = current.tick;
+    view.entities.clear();
+    for (const auto & candidate : candidates) {
+        client.relevant.push_back(candidate.first);
+        view.entities.push_back(current.entities[candidate.second]);
+    }
+}
+
+void ReplicationService::SendSnapshot(Client & client)
+{
+    const Snapshot* baseline = &emptySnapshot;
+    if (client.ackedSequence != SnapshotCodec::NO_BASELINE) {
+        const auto & acked = client.history[client.ackedSequence % HISTORY_SIZE];
+        if (acked.sequence == client.ackedSequence) {
+            baseline = &acked;
+        }
+    }
+
+    // The baseline may share the history slot with the current snapshot
+    // only if it is as old as the history, send full state in that case.
+    auto & sent = client.history[view.sequence % HISTORY_SIZE];
+    if (baseline == &sent) {
+        baseline = &emptySnapshot;
+    }
+
+    // Full state starts over at the lowest id, so consecutive full state
+    // snapshots contain the same entities until one of them is acknowledged.
+    if (baseline == &emptySnapshot) {
+        client.cursor = 0;
+    }
+
+    const auto & pose = client.player->GetComponent<Pose2D>();
+    ClientInfo info;
+    info.tickRate = static_cast<uint16_t>(tickRate);
+    info.playerId = client.player->GetComponent<Replicated>().id;
+    info.lastInput = client.lastInput;
+    info.playerX = SnapshotCodec::QuantizePosition(pose.pos.x);
+    info.playerY = SnapshotCodec::QuantizePosition(pose.pos.y);
+    info.playerAngle = SnapshotCodec::QuantizeAngle(pose.angle);
+
+    packet.Clear();
+    NetProtocol::WriteHeader(packet, MessageType::SNAPSHOT);
+    info.Write(packet);
+    SnapshotCodec::Encode(view, *baseline, NetProtocol::MAX_PACKET_SIZE, 
+        client.cursor, packet, sent);
+
+    if (socket->Send(client.address, packet.GetData(), packet.GetSize())) {
+        numBytesSent += packet.GetSize();
+    }
+}
@@ -0,0 +1,262 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <UpdateService.h>
+#include <EntityService.h>
+
+#include "UdpSocket.h"
+#include "NetBuffer.h"
+#include "Snapshot.h"
+#include "SoaComponentStore.h"
+#include "PlayerMovement.h"
+#include "SpatialGrid.h"
+
+/**
+ * Replicates the state of the entities to the connected clients.
+ * 
+ * Clients join by sending a HELLO message to the server's UDP port and
+ * acknowledge each received snapshot. Each client controls a player entity,
+ * one of the inputs sent by the client is applied to it per update.
+ * 
+ * Clients receive only the entities within the view radius around their
+ * player entity. Entities enter the view within the view radius and leave
+ * it beyond the view radius plus a margin, so entities close to the edge
+ * do not pop in and out. Snapshots are delta-encoded against
+ * the latest snapshot acknowledged by the respective client and are limited
+ * to a single datagram, hence the bandwidth per client is bounded no matter
+ * how many entities exist. This service should be updated after all services
+ * which modify or remove replicated entities.
+ */
+class ReplicationService : public astu::UpdatableBaseService {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param port          the UDP port to listen on
+     * @param tickRate      the number of updates per second
+     * @param snapshotRate  the number of snapshots sent per second
+     * @param priority      the update priority of this service
+     */
+    ReplicationService(uint16_t port, int tickRate, int snapshotRate = 20, int priority = 0);
+
+    /**
+     * Sets the area of interest of the clients.
+     * 
+     * @param radius    the distance within which entities become relevant
+     * @param margin    the additional distance before entities become
+     *                  irrelevant again
+     * @throws std::domain_error in case the radius is not positive or the
+     *                  margin is negative
+     */
+    void SetViewRadius(double radius, double margin);
+
+    /**
+     * Returns the number of connected clients.
+     * 
+     * @return the number of clients
+     */
+    size_t GetNumClients() const {
+        return clients.size();
+    }
+
+    /**
+     * Returns the number of bytes sent since the service has been started.
+     * 
+     * @return the number of bytes sent
+     */
+    uint64_t GetNumBytesSent() const {
+        return numBytesSent;
+    }
+
+protected:
+
+    // Inherited via UpdatableBaseService
+    virtual void OnStartup() override;
+    virtual void OnShutdown() override;
+    virtual void OnUpdate() override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /** The state of a connected client. */
+    struct Client {
+        /** The address of the client. */
+        NetAddress address;
+
+        /** The sequence number of the latest snapshot acknowledged. */
+        uint32_t ackedSequence;
+
+        /** The id to start encoding changes with, see SnapshotCodec. */
+        uint32_t cursor;
+
+        /** The point in time the client has been heard of last. */
+        Clock::time_point lastHeard;
+
+        /** The snapshots recently sent, indexed by sequence number. */
+        std::vector<Snapshot> history;
+
+        /** The entity controlled by the client. */
+        std::shared_ptr<astu::Entity> player;
+
+        /** The inputs received but not yet processed, indexed by sequence number. */
+        std::vector<PlayerInput> inputs;
+
+        /** The sequence number of the latest input received. */
+        uint32_t receivedInput;
+
+        /** The sequence number of the last input processed. */
+        uint32_t lastInput;
+
+        /** The network ids of the entities relevant to the client, sorted. */
+        std::vector<uint32_t> relevant;
+    };
+
+    /** The UDP port to listen on. */
+    uint16_t port;
+
+    /** The number of updates per second. */
+    int tickRate;
+
+    /** The number of updates between two snapshots. */
+    int sendInterval;
+
+    /** The number of updates so far. */
+    uint32_t tick;
+
+    /** The network id of the next player entity. */
+    uint32_t nextPlayerId;
+
+    /** The number of updates since the last snapshot. */
+    int updateCounter;
+
+    /** The sequence number of the current snapshot. */
+    uint32_t sequence;
+
+    /** The number of bytes sent so far. */
+    uint64_t numBytesSent;
+
+    /** The socket used to communicate with the clients. */
+    std::unique_ptr<UdpSocket> socket;
+
+    /** The connected clients. */
+    std::vector<Client> clients;
+
+    /** The current state of all replicated entities. */
+    Snapshot current;
+
+    /** Used as baseline for clients without acknowledged snapshots. */
+    Snapshot emptySnapshot;
+
+    /** The part of the current snapshot relevant to a single client. */
+    Snapshot view;
+
+    /** The distance within which entities become relevant. */
+    double enterRadius;
+
+    /** The distance beyond which entities become irrelevant. */
+    double leaveRadius;
+
+    /** Indexes the entities of the current snapshot by location. */
+    SpatialGrid grid;
+
+    /** The entities close to a client, as network id and snapshot index. */
+    std::vector<std::pair<uint32_t, uint32_t>> candidates;
+
+    /** Used to assemble outgoing datagrams. */
+    OutputBuffer packet;
+
+    /** Receives incoming datagrams. */
+    std::vector<uint8_t> receiveBuffer;
+
+    /** The view to the replicated entities with pose components. */
+    std::shared_ptr<astu::EntityView> entityView;
+
+    /** The view to the replicated entities with linear movement components. */
+    std::shared_ptr<astu::EntityView> movingView;
+
+    /** The view to the replicated entities kept in the dense store, if any. */
+    std::shared_ptr<astu::EntityView> denseView;
+
+    /** The optional dense component store. */
+    std::shared_ptr<SoaComponentStore> store;
+
+    /**
+     * Handles all pending datagrams.
+     */
+    void ReceiveMessages();
+
+    /**
+     * Adds a client and spawns its player entity.
+     * 
+     * @param address   the address of the client
+     * @return the new client
+     */
+    Client & AddClient(const NetAddress & address);
+
+    /**
+     * Removes a client and its player entity.
+     * 
+     * @param idx   the index of the client
+     */
+    void RemoveClient(size_t idx);
+
+    /**
+     * Stores the player inputs of an input message.
+     * 
+     * @param client    the sending client
+     * @param in        the message, following the header
+     */
+    void ReceiveInputs(Client & client, InputBuffer & in);
+
+    /**
+     * Applies the next pending input of each client to its player entity.
+     */
+    void ApplyInputs();
+
+    /**
+     * Searches a client by address.
+     * 
+     * @param address   the address of the client
+     * @return the client or null if not connected
+     */
+    Client* FindClient(const NetAddress & address);
+
+    /**
+     * Drops clients which have not been heard of for some time.
+     */
+    void DropIdleClients();
+
+    /**
+     * Captures the current state of all replicated entities.
+     */
+    void CaptureSnapshot();
+
+    /**
+     * Updates the entities relevant to a client and extracts them from 
+     * the current snapshot.
+     * 
+     * @param client    the client
+     */
+    void UpdateView(Client & client);
+
+    /**
+     * Sends the view of the current snapshot to a client.
+     * 
+     * @param client    the receiving client
+     */
+    void SendSnapshot(Client & client);
+};
@@ -0,0 +1,83 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#include <algorithm>
+#include <limits>
+#include "TickStatistics.h"
+
+TickStatistics::TickStatistics(double budget, size_t capacity)
+    : budget(budget)
+{
+    samples.reserve(capacity);
+    Reset();
+}
+
+void TickStatistics::AddTick(double seconds)
+{
+    // Percentiles refer to the first ticks in case the capacity is exceeded.
+    if (samples.size() < samples.capacity()) {
+        samples.push_back(seconds);
+    }
+
+    ++numTicks;
+    sum += seconds;
+    minTime = std::min(minTime, seconds);
+    maxTime = std::max(maxTime, seconds);
+    if (budget > 0 && seconds > budget) {
+        ++numOverruns;
+    }
+}
+
+void TickStatistics::Report(std::ostream & os)
+{
+    if (numTicks == 0) {
+        os << "no ticks, " << numSkipped << " skipped" << std::endl;
+        Reset();
+        return;
+    }
+
+    const double avg = sum / numTicks;
+    auto percentile = [this, avg](double p) {
+        if (samples.empty()) {
+            return avg;
+        }
+        auto it = samples.begin() + static_cast<size_t>(p * (samples.size() - 1));
+        std::nth_element(samples.begin(), it, samples.end());
+        return *it;
+    };
+
+    os << numTicks << " ticks: "
+        << "avg " << 1000.0 * avg << " ms, "
+        << "min " << 1000.0 * minTime << " ms, "
+        << "p50 " << 1000.0 * percentile(0.5) << " ms, "
+        << "p99 " << 1000.0 * percentile(0.99) << " ms, "
+        << "max " << 1000.0 * maxTime << " ms";
+
+    if (budget > 0) {
+        os << ", load " << 100.0 * avg / budget << " %, "
+            << numOverruns << " overruns, "
+            << numSkipped << " skipped";
+    }
+    os << std::endl;
+
+    Reset();
+}
+
+void TickStatistics::Reset()
+{
+    samples.clear();
+    numTicks = 0;
+    numOverruns = 0;
+    numSkipped = 0;
+    sum = 0;
+    minTime = std::numeric_limits<double>::max();
+    maxTime = 0;
+}
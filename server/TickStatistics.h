@@ -0,0 +1,93 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+#pragma once
+
+#include <vector>
+#include <ostream>
+
+/**
+ * Collects the durations of server ticks and reports them periodically.
+ * 
+ * Memory for the samples is reserved up-front, recording a tick does
+ * not allocate memory as long as the capacity is not exceeded.
+ */
+class TickStatistics {
+public:
+
+    /**
+     * Constructor.
+     * 
+     * @param budget    the time available per tick in seconds
+     * @param capacity  the number of ticks to reserve memory for
+     */
+    TickStatistics(double budget, size_t capacity);
+
+    /**
+     * Records the duration of a tick.
+     * 
+     * @param seconds   the time spent on the tick in seconds
+     */
+    void AddTick(double seconds);
+
+    /**
+     * Records a tick which started too late to be caught up.
+     */
+    void AddSkippedTick() {
+        ++numSkipped;
+    }
+
+    /**
+     * Returns the number of ticks recorded since the last report.
+     * 
+     * @return the number of recorded ticks
+     */
+    size_t GetNumTicks() const {
+        return numTicks;
+    }
+
+    /**
+     * Writes the statistics of the recorded ticks and starts over.
+     * 
+     * @param os    the output stream to write to
+     */
+    void Report(std::ostream & os);
+
+private:
+    /** The time available per tick in seconds. */
+    double budget;
+
+    /** The recorded tick durations, used to compute percentiles. */
+    std::vector<double> samples;
+
+    /** The number of ticks recorded since the last report. */
+    size_t numTicks;
+
+    /** The number of ticks which exceeded the budget. */
+    size_t numOverruns;
+
+    /** The number of ticks which have been skipped. */
+    size_t numSkipped;
+
+    /** The total time spent on the recorded ticks. */
+    double sum;
+
+    /** The shortest recorded tick. */
+    double minTime;
+
+    /** The longest recorded tick. */
+    double maxTime;
+
+    /**
+     * Resets the statistics.
+     */
+    void Reset();
+};
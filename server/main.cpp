@@ -0,0 +1,182 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+// Standard C++ Library
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <csignal>
+#include <cstdlib>
+
+// AST Utilities
+#include <AstUtils.h>
+#include <ServiceManager.h>
+#include <UpdateService.h>
+#include <EntityService.h>
+
+// Bagaga Commons
+#include "FixedTimeService.h"
+#include "HeadlessWindowManager.h"
+#include "AutoRotateSystem.h"
+#include "LinearMovementSystem.h"
+#include "CollisionDetectionSystem.h"
+#include "SoaComponentStore.h"
+#include "EntityDestroyQueue.h"
+#include "FrameProfiler.h"
+
+// Server services
+#include "MatchService.h"
+#include "TickStatistics.h"
+#include "ReplicationService.h"
+#include "NetProtocol.h"
+
+using namespace std;
+using namespace astu;
+
+const std::string kAppName = "Bagaga Server";
+const std::string kAppVersion = "0.1.0";
+
+/** The number of ticks per second, unless specified otherwise. */
+const int kDefaultTickRate = 60;
+
+/** The size of the world, used as boundary by the movement system. */
+const int kWorldWidth = 1280;
+const int kWorldHeight = 720;
+
+/** The number of entities of a match. */
+const size_t kNumEntities = 200;
+
+/** The number of seconds between two tick statistics reports. */
+const int kReportInterval = 5;
+
+/** The number of snapshots sent to the clients per second. */
+const int kSnapshotRate = 20;
+
+/** The number of ticks the server may fall behind before it skips ticks. */
+const int kMaxLag = 5;
+
+/** Set by the signal handler to shut the server down. */
+volatile std::sig_atomic_t quit = 0;
+
+void HandleSignal(int)
+{
+	quit = 1;
+}
+
+/**
+ * Adds the services of the server, no SDL services are used.
+ * 
+ * @param tickRate	the number of ticks per second
+ * @param port		the UDP port to listen for clients on
+ */
+void AddServices(int tickRate, uint16_t port)
+{
+	// Fetch service manager (realized as a singleton)
+	auto &sm = ServiceManager::GetInstance();
+
+	// Add basic functionality.
+	sm.AddService(std::make_shared<UpdateService>());
+#ifdef BAGAGA_PROFILER
+	sm.AddService(std::make_shared<FrameProfiler>("bagaga_server_trace.json"));
+#endif
+
+	// Ticks are simulated with a fixed time step, the window manager 
+	// only defines the boundaries of the world.
+	sm.AddService(std::make_shared<HeadlessWindowManager>(kWorldWidth, kWorldHeight));
+	sm.AddService(std::make_shared<FixedTimeService>(1.0 / tickRate));
+
+	// Add the simulation. No job system is added, several matches are 
+	// expected to run side by side on the same machine.
+	sm.AddService(std::make_shared<EntityService>());
+	sm.AddService(std::make_shared<SoaComponentStore>(kNumEntities));
+	sm.AddService(std::make_shared<AutoRotateSystem>());
+	sm.AddService(std::make_shared<LinearMovementSystem>());
+	sm.AddService(std::make_shared<CollisionDetectionSystem>());
+	sm.AddService(std::make_shared<MatchService>(kNumEntities));
+	sm.AddService(std::make_shared<EntityDestroyQueue>());
+
+	// Snapshots are taken after all entities have been updated.
+	sm.AddService(std::make_shared<ReplicationService>(port, tickRate, kSnapshotRate));
+}
+
+int main(int argc, char* argv[])
+{
+	SayVersion();
+
+	int tickRate = argc > 1 ? std::atoi(argv[1]) : kDefaultTickRate;
+	long numTicks = argc > 2 ? std::atol(argv[2]) : 0;
+	int port = argc > 3 ? std::atoi(argv[3]) : NetProtocol::DEFAULT_PORT;
+	if (tickRate <= 0 || numTicks < 0 || port <= 0 || port > 65535) {
+		std::cerr << "usage: " << argv[0] << " [ticks per second] [number of ticks] [port]" << std::endl;
+		return -1;
+	}
+
+	std::signal(SIGINT, HandleSignal);
+	std::signal(SIGTERM, HandleSignal);
+
+	AddServices(tickRate, static_cast<uint16_t>(port));
+
+	// Fetch service manager (realized as a singleton)
+	auto &sm = ServiceManager::GetInstance();
+	sm.GetService<IWindowManager>().SetTitle(kAppName + " - Version " + kAppVersion);
+
+	// Start services
+	sm.StartupAll();
+	std::cout << kAppName << " running at " << tickRate << " ticks/s" << std::endl;
+
+	using Clock = std::chrono::steady_clock;
+	const auto tickPeriod = std::chrono::duration_cast<Clock::duration>(
+		std::chrono::duration<double>(1.0 / tickRate));
+	const long reportTicks = static_cast<long>(tickRate) * kReportInterval;
+	TickStatistics stats(1.0 / tickRate, reportTicks);
+
+	auto &updater = sm.GetService<UpdateService>();
+	auto &replication = sm.GetService<ReplicationService>();
+	uint64_t bytesReported = 0;
+	auto nextTick = Clock::now();
+	for (long tick = 0; !quit && (numTicks == 0 || tick < numTicks); ++tick) {
+		auto start = Clock::now();
+		updater.UpdateAll();
+		auto end = Clock::now();
+		stats.AddTick(std::chrono::duration<double>(end - start).count());
+
+		// Ticks are scheduled at fixed points in time, short delays are
+		// caught up, in case of long delays ticks are skipped instead.
+		nextTick += tickPeriod;
+		while (end - nextTick > kMaxLag * tickPeriod) {
+			nextTick += tickPeriod;
+			stats.AddSkippedTick();
+		}
+		std::this_thread::sleep_until(nextTick);
+
+		if ((tick + 1) % reportTicks == 0) {
+			stats.Report(std::cout);
+
+			const uint64_t bytes = replication.GetNumBytesSent() - bytesReported;
+			bytesReported += bytes;
+			if (replication.GetNumClients() > 0) {
+				std::cout << replication.GetNumClients() << " clients, " 
+					<< bytes / (1024.0 * kReportInterval * replication.GetNumClients()) 
+					<< " KiB/s per client" << std::endl;
+			}
+		}
+	}
+
+	if (stats.GetNumTicks() > 0) {
+		stats.Report(std::cout);
+	}
+
+	// Shutdown services.
+	sm.ShutdownAll();
+
+	return 0;
+}
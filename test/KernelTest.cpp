@@ -0,0 +1,160 @@
+/*  ____          _____          _____          
+ * |  _ \   /\   / ____|   /\   / ____|   /\    
+ * | |_) | /  \ | |  __   /  \ | |  __   /  \   
+ * |  _ < / /\ \| | |_ | / /\ \| | |_ | / /\ \  
+ * | |_) / ____ \ |__| |/ ____ \ |__| |/ ____ \ 
+ * |____/_/    \_\_____/_/    \_\_____/_/    \_\
+ *
+ * Bagaga - Bloody Amazing Game Architecture Game
+ * Copyright 2020 Bagaga Development Team. All rights reserved.                                             
+ */
+
+// Standard C++ Library
+#include <iostream>
+#include <vector>
+#include <random>
+#include <limits>
+#include <cstring>
+#include <cstdint>
+
+// Bagaga Commons
+#include "LinearMovementKernel.h"
+
+using namespace std;
+
+/** The boundaries used by all test cases. */
+const double kWidth = 640;
+const double kHeight = 480;
+
+/** The largest number of elements tested, covers all remainders. */
+const size_t kMaxElements = 67;
+
+/** The number of random test cases per number of elements. */
+const int kNumRounds = 200;
+
+/**
+ * The input of one test case, processed by both implementations.
+ */
+struct TestCase {
+	vector<double> px;
+	vector<double> py;
+	vector<double> vx;
+	vector<double> vy;
+	vector<uint8_t> flags;
+	uint8_t mask;
+	double dt;
+};
+
+/**
+ * Returns a random coordinate, including values out of bounds, on the
+ * boundaries and signed zeros.
+ */
+double RandomCoordinate(mt19937 & rng, double limit)
+{
+	switch (uniform_int_distribution<int>(0, 7)(rng)) {
+	case 0:
+		return -0.0;
+	case 1:
+		return 0.0;
+	case 2:
+		return limit;
+	case 3:
+		return limit - 1;
+	case 4:
+		return uniform_real_distribution<double>(-2 * limit, -1e-12)(rng);
+	case 5:
+		return uniform_real_distribution<double>(limit, 3 * limit)(rng);
+	default:
+		return uniform_real_distribution<double>(0, limit)(rng);
+	}
+}
+
+/**
+ * Returns a random velocity, including signed zeros.
+ */
+double RandomVelocity(mt19937 & rng)
+{
+	switch (uniform_int_distribution<int>(0, 5)(rng)) {
+	case 0:
+		return -0.0;
+	case 1:
+		return 0.0;
+	default:
+		return uniform_real_distribution<double>(-1000, 1000)(rng);
+	}
+}
+
+TestCase CreateTestCase(mt19937 & rng, size_t n)
+{
+	TestCase tc;
+	for (size_t i = 0; i < n; ++i) {
+		tc.px.push_back(RandomCoordinate(rng, kWidth));
+		tc.py.push_back(RandomCoordinate(rng, kHeight));
+		tc.vx.push_back(RandomVelocity(rng));
+		tc.vy.push_back(RandomVelocity(rng));
+		tc.flags.push_back(static_cast<uint8_t>(uniform_int_distribution<int>(0, 7)(rng)));
+	}
+	tc.mask = static_cast<uint8_t>(uniform_int_distribution<int>(1, 7)(rng));
+
+	const double dts[] = { 0.0, -0.0, 1.0 / 60.0, 1.0 / 144.0, 0.25 };
+	tc.dt = dts[uniform_int_distribution<int>(0, 4)(rng)];
+	return tc;
+}
+
+/**
+ * Tests whether two arrays are equal bit for bit.
+ */
+bool BitwiseEqual(const vector<double> & a, const vector<double> & b)
+{
+	return a.size() == b.size() 
+		&& (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0);
+}
+
+/**
+ * Runs both implementations on a test case and compares the results.
+ * 
+ * @return `true` if the results are equal bit for bit
+ */
+bool RunTestCase(const TestCase & tc)
+{
+	TestCase simd = tc;
+	TestCase scalar = tc;
+
+	IntegrateAndReflect(simd.px.data(), simd.py.data(), simd.vx.data(), simd.vy.data(), 
+		simd.flags.data(), simd.mask, simd.px.size(), simd.dt, kWidth, kHeight);
+	IntegrateAndReflectScalar(scalar.px.data(), scalar.py.data(), scalar.vx.data(), scalar.vy.data(), 
+		scalar.flags.data(), scalar.mask, scalar.px.size(), scalar.dt, kWidth, kHeight);
+
+	return BitwiseEqual(simd.px, scalar.px) && BitwiseEqual(simd.py, scalar.py)
+		&& BitwiseEqual(simd.vx, scalar.vx) && BitwiseEqual(simd.vy, scalar.vy);
+}
+
+int main()
+{
+	mt19937 rng(12345);
+	int numFailed = 0;
+	int numTests = 0;
+
+	for (size_t n = 0; n <= kMaxElements; ++n) {
+		for (int round = 0; round < kNumRounds; ++round) {
+			++numTests;
+			if (!RunTestCase(CreateTestCase(rng, n))) {
+				if (++numFailed <= 10) {
+					cerr << "mismatch for " << n << " elements in round " << round << endl;
+				}
+			}
+		}
+	}
+
+	// A large batch, as processed by the movement system.
+	for (int round = 0; round < 10; ++round) {
+		++numTests;
+		if (!RunTestCase(CreateTestCase(rng, 10007))) {
+			++numFailed;
+			cerr << "mismatch for large batch in round " << round << endl;
+		}
+	}
+
+	cout << numTests - numFailed << " of " << numTests << " kernel tests passed" << endl;
+	return numFailed == 0 ? 0 : 1;
+}